@@ -1,17 +1,45 @@
 // FILE: IntSet.h - header file for IntSet class
-// CLASS PROVIDED: IntSet (a container class for a set of
-//                 int values)
+// CLASS PROVIDED: BasicIntSet<N> (a container class template for a
+//                 set of at most N int values, stored in the object
+//                 itself), and
+//                 IntSet (a typedef for BasicIntSet<10>)
+//
+// TEMPLATE PARAMETER
+//   int N
+//     The highest # of elements a BasicIntSet<N> can accommodate
+//     (N >= 1). The elements are kept in an int[N] array member, so
+//     a BasicIntSet<N> never uses the heap.
 //
 // CONSTANT
-//   static const int MAX_SIZE = ____
+//   static constexpr int MAX_SIZE = N
 //     IntSet::MAX_SIZE is the highest # of elements an IntSet
 //     can accommodate.
 //
-// CONSTRUCTOR
-//   IntSet()
+// CONSTEXPR SUPPORT
+//   Every member function except DumpData (and the non-member
+//   function equal) is constexpr, so a BasicIntSet can be built and
+//   combined in constant expressions; e.g., a table of small sets
+//   declared as
+//      constexpr IntSet PRIMES = { 2, 3, 5, 7 };
+//      constexpr IntSet ODDS = { 1, 3, 5, 7, 9 };
+//      constexpr IntSet ODD_PRIMES = PRIMES.intersect(ODDS);
+//   is computed by the compiler and costs nothing at run time.
+//   IntSetConstexpr.cpp checks this with static_asserts (make
+//   constexpr).
+//
+// CONSTRUCTORS
+//   BasicIntSet()
 //     Pre:  (none)
 //     Post: The invoking IntSet is initialized to an empty
 //           IntSet (i.e., one containing no relevant elements).
+//   BasicIntSet(std::initializer_list<int> values)
+//     Pre:  values has at most MAX_SIZE distinct values.
+//     Post: The invoking IntSet is initialized to the set of the
+//           distinct values in values, with membership in the order
+//           of their first occurrences (as if added one by one).
+//     Note: If Pre is not met, std::length_error is thrown, so a
+//           constexpr IntSet with too many values doesn't compile
+//           (rather than silently keeping the first MAX_SIZE).
 //
 // CONSTANT MEMBER FUNCTIONS (ACCESSORS)
 //   int size() const
@@ -25,7 +53,7 @@
 //     Pre:  (none)
 //     Post: true is returned if the invoking IntSet has anInt as an
 //           element, otherwise false is returned.
-//   bool isSubsetOf(const IntSet& otherIntSet) const
+//   bool isSubsetOf(const BasicIntSet& otherIntSet) const
 //     Pre:  (none)
 //     Post: True is returned if all elements of the invoking IntSet
 //           are also elements of otherIntSet, otherwise false is
@@ -38,7 +66,7 @@
 //     Post: Contents of the invoking IntSet have been inserted into
 //           out with 2 spaces separating one item from another if
 //           if there are 2 or more items.
-//   IntSet unionWith(const IntSet& otherIntSet) const
+//   BasicIntSet unionWith(const BasicIntSet& otherIntSet) const
 //     Pre:  size() + (otherIntSet.subtract(*this)).size() <= MAX_SIZE
 //     Post: An IntSet representing the union of the invoking IntSet
 //           and otherIntSet is returned.
@@ -46,7 +74,7 @@
 //           returned is one that initially is an exact copy of the
 //           invoking IntSet but subsequently has all elements of
 //           otherIntSet added.
-//   IntSet intersect(const IntSet& otherIntSet) const
+//   BasicIntSet intersect(const BasicIntSet& otherIntSet) const
 //     Pre:  (none)
 //     Post: An IntSet representing the intersection of the invoking
 //           IntSet and otherIntSet is returned.
@@ -54,7 +82,7 @@
 //           returned is one that initially is an exact copy of the
 //           invoking IntSet but subsequently has all of its elements
 //           that are not also elements of otherIntSet removed.
-//   IntSet subtract(const IntSet& otherIntSet) const
+//   BasicIntSet subtract(const BasicIntSet& otherIntSet) const
 //     Pre:  (none)
 //     Post: An IntSet representing the difference between the invoking
 //           IntSet and otherIntSet is returned.
@@ -82,7 +110,8 @@
 //           and false is returned.
 //
 // NON-MEMBER FUNCTIONS
-//   bool equal(const IntSet& is1, const IntSet& is2)
+//   template <int N>
+//   bool equal(const BasicIntSet<N>& is1, const BasicIntSet<N>& is2)
 //     Pre:  (none)
 //     Post: True is returned if is1 and is2 have the same elements,
 //           otherwise false is returned; for e.g.: {1,2,3}, {1,3,2},
@@ -92,30 +121,40 @@
 #ifndef INT_SET_H
 #define INT_SET_H
 
+#include <initializer_list>
 #include <iostream>
+#include <stdexcept>
 
-class IntSet
+template <int N>
+class BasicIntSet
 {
+   static_assert(N >= 1, "a BasicIntSet must hold at least 1 element");
 public:
-   static const int MAX_SIZE = 10;
-   IntSet();
-   int size() const;
-   bool isEmpty() const;
-   bool contains(int anInt) const;
-   bool isSubsetOf(const IntSet& otherIntSet) const;
+   static constexpr int MAX_SIZE = N;
+   constexpr BasicIntSet();
+   constexpr BasicIntSet(std::initializer_list<int> values);
+   constexpr int size() const;
+   constexpr bool isEmpty() const;
+   constexpr bool contains(int anInt) const;
+   constexpr bool isSubsetOf(const BasicIntSet& otherIntSet) const;
    void DumpData(std::ostream& out) const;
-   IntSet unionWith(const IntSet& otherIntSet) const;
-   IntSet intersect(const IntSet& otherIntSet) const;
-   IntSet subtract(const IntSet& otherIntSet) const;
-   void reset();
-   bool add(int anInt);
-   bool remove(int anInt);
+   constexpr BasicIntSet unionWith(const BasicIntSet& otherIntSet) const;
+   constexpr BasicIntSet intersect(const BasicIntSet& otherIntSet) const;
+   constexpr BasicIntSet subtract(const BasicIntSet& otherIntSet) const;
+   constexpr void reset();
+   constexpr bool add(int anInt);
+   constexpr bool remove(int anInt);
 
 private:
    int data[MAX_SIZE];
    int used;
 };
 
-bool equal(const IntSet& is1, const IntSet& is2);
+template <int N>
+constexpr bool equal(const BasicIntSet<N>& is1, const BasicIntSet<N>& is2);
+
+typedef BasicIntSet<10> IntSet;
+
+#include "IntSet.template"
 
 #endif
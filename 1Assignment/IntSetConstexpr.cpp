@@ -0,0 +1,81 @@
+// FILE: IntSetConstexpr.cpp
+//       A compile-time check of the CONSTEXPR SUPPORT of BasicIntSet
+//       (see IntSet.h): every static_assert below is evaluated by the
+//       compiler, so this file compiles only if the constructors,
+//       unionWith, intersect, subtract, add, remove, reset and the
+//       accessors work in constant expressions and give the right
+//       sets. Compiled with -DINTSET_TOO_MANY_VALUES it also declares
+//       a constexpr IntSet with more than MAX_SIZE distinct values,
+//       which must NOT compile (make constexpr checks both).
+
+#include "IntSet.h"
+#include <cstdlib>
+#include <iostream>
+using namespace std;
+
+constexpr IntSet EMPTY;
+constexpr IntSet PRIMES = { 2, 3, 5, 7 };
+constexpr IntSet ODDS = { 1, 3, 5, 7, 9, 9, 1 };
+constexpr IntSet FULL = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 9 };
+
+// Returns set with anInt added and then removed (the members after it
+// shift down)
+constexpr IntSet add_then_remove(IntSet set, int anInt, int toRemove)
+{
+   set.add(anInt);
+   set.remove(toRemove);
+   return set;
+}
+
+// Returns set after reset() and one add
+constexpr IntSet reset_then_add(IntSet set, int anInt)
+{
+   set.reset();
+   set.add(anInt);
+   return set;
+}
+
+// Constructors and accessors
+static_assert(EMPTY.isEmpty() && EMPTY.size() == 0, "default ctor");
+static_assert(PRIMES.size() == 4 && PRIMES.contains(5)
+              && !PRIMES.contains(4), "initializer_list ctor");
+static_assert(ODDS.size() == 5, "duplicates in the list are dropped");
+static_assert(FULL.size() == IntSet::MAX_SIZE, "MAX_SIZE values fit");
+static_assert(EMPTY.isSubsetOf(PRIMES) && !PRIMES.isSubsetOf(ODDS),
+              "isSubsetOf");
+
+// unionWith, intersect, subtract
+static_assert(equal(PRIMES.unionWith(ODDS), IntSet{ 1, 2, 3, 5, 7, 9 }),
+              "unionWith");
+static_assert(PRIMES.unionWith(PRIMES).size() == 4, "unionWith itself");
+static_assert(equal(PRIMES.intersect(ODDS), IntSet{ 3, 5, 7 }),
+              "intersect");
+static_assert(PRIMES.intersect(EMPTY).isEmpty(), "intersect with empty");
+static_assert(equal(PRIMES.subtract(ODDS), IntSet{ 2 }), "subtract");
+static_assert(equal(ODDS.subtract(PRIMES), IntSet{ 1, 9 }),
+              "subtract the other way");
+static_assert(FULL.subtract(FULL).isEmpty(), "subtract itself");
+static_assert(equal(FULL.intersect(ODDS).unionWith(PRIMES)
+                       .subtract(IntSet{ 9 }),
+                    IntSet{ 1, 2, 3, 5, 7 }), "a chain of operations");
+
+// add, remove, reset
+static_assert(equal(add_then_remove(PRIMES, 11, 3), IntSet{ 2, 5, 7, 11 }),
+              "add and remove");
+static_assert(add_then_remove(PRIMES, 2, 99).size() == 4,
+              "adding a member and removing a non-member change nothing");
+static_assert(add_then_remove(FULL, 10, 0).size() == IntSet::MAX_SIZE - 1
+              && !add_then_remove(FULL, 10, 0).contains(10),
+              "a full IntSet refuses a new value");
+static_assert(equal(reset_then_add(FULL, 42), IntSet{ 42 }), "reset");
+
+#ifdef INTSET_TOO_MANY_VALUES
+constexpr IntSet TOO_MANY = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+#endif
+
+int main()
+{
+   cout << "All IntSet constant expressions checked at compile time"
+        << endl;
+   return EXIT_SUCCESS;
+}
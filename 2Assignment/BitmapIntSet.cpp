@@ -0,0 +1,705 @@
+// FILE: BitmapIntSet.cpp - implementation file for the BitmapIntSet
+//       class (See BitmapIntSet.h for documentation.)
+// INVARIANT for the BitmapIntSet class:
+// (1) An int value v is mapped to the unsigned u = v ^ 0x80000000
+//     (which orders negative values before positive ones); the high
+//     16 bits of u are v's chunk key and the low 16 bits are v's
+//     position within that chunk.
+// (2) chunks holds exactly one Chunk per key that has at least one
+//     member, in strictly ascending key order; no chunk is empty.
+// (3) Each chunk's cardinality is its # of members, and used is the
+//     sum of all cardinalities.
+// (4) An ARRAY chunk stores its members' positions in low, strictly
+//     ascending, and has at most ARRAY_MAX members; words is empty.
+// (5) A BITSET chunk stores its members as set bits of words (bit
+//     p % 64 of words[p / 64] for position p) and has more than
+//     ARRAY_MAX members; low is empty.
+// (6) A RUN chunk stores its members in low as (start, length)
+//     pairs: positions start through start + length, with the runs
+//     in ascending order and separated by at least one non-member;
+//     words is empty. Only runOptimize creates RUN chunks.
+//
+// DOCUMENTATION for private member (helper) functions:
+//   int findChunk(unsigned key) const
+//     Post: The index of the first chunk whose key is not less than
+//           key is returned (chunks.size() if there is none).
+//   BitmapIntSet combine(const BitmapIntSet& otherIntSet,
+//                        SetOperation op) const
+//     Post: The union, intersection or difference (per op) of the
+//           invoking BitmapIntSet and otherIntSet is returned.
+//   static void toWords(const Chunk& chunk, unsigned long long* words)
+//     Pre:  words has room for WORDS_PER_CHUNK words.
+//     Post: words holds chunk's members as a bitset, whatever the
+//           type of chunk.
+//   static void fromWords(Chunk& chunk, const unsigned long long* words)
+//     Post: chunk's members are those of the bitset words, stored as
+//           an ARRAY or BITSET per the invariant (key is unchanged).
+//   static void expandRuns(Chunk& chunk)
+//     Post: chunk has been converted to ARRAY or BITSET (if it was a
+//           RUN chunk); its members are unchanged.
+//   static bool chunkContains(const Chunk& chunk, unsigned short low)
+//     Post: true is returned if position low is a member of chunk.
+//   static bool combineSparse(const Chunk& a, const Chunk& b,
+//                             SetOperation op, Chunk& result)
+//     Post: If the combination can be done without bitsets (a is an
+//           ARRAY and either b is also an ARRAY or op is not UNION),
+//           result holds a op b and true is returned; otherwise
+//           false is returned and result is unchanged.
+
+#include "BitmapIntSet.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+using namespace std;
+
+namespace
+{
+   const int ARRAY_MAX = 4096;        // largest ARRAY chunk
+   const int WORDS_PER_CHUNK = 1024;  // 65536 bits
+
+   unsigned toKeySpace(int anInt)
+   {
+      return static_cast<unsigned>(anInt) ^ 0x80000000u;
+   }
+
+   int fromKeySpace(unsigned key, unsigned low)
+   {
+      return static_cast<int>(((key << 16) | low) ^ 0x80000000u);
+   }
+
+   int popcount64(unsigned long long word)
+   {
+#if defined(__GNUC__)
+      return __builtin_popcountll(word);
+#else
+      int count = 0;
+      for (; word != 0; word &= word - 1)
+         ++count;
+      return count;
+#endif
+   }
+
+   int lowestBit(unsigned long long word)
+   {
+#if defined(__GNUC__)
+      return __builtin_ctzll(word);
+#else
+      int bit = 0;
+      while (!(word & 1))
+      {
+         word >>= 1;
+         ++bit;
+      }
+      return bit;
+#endif
+   }
+
+   // Sets bits first through last (inclusive) of words
+   void setRange(unsigned long long* words, unsigned first, unsigned last)
+   {
+      for (unsigned w = first / 64; w <= last / 64; ++w)
+      {
+         unsigned lo = (w == first / 64) ? first % 64 : 0;
+         unsigned hi = (w == last / 64) ? last % 64 : 63;
+         unsigned long long mask =
+            (hi == 63) ? ~0ULL : ((1ULL << (hi + 1)) - 1);
+         mask &= ~((1ULL << lo) - 1);
+         words[w] |= mask;
+      }
+   }
+}
+
+BitmapIntSet::BitmapIntSet() : used(0)
+{
+}
+
+int BitmapIntSet::findChunk(unsigned key) const
+{
+   int low = 0;
+   int high = static_cast<int>(chunks.size());
+   while (low < high)
+   {
+      int mid = low + (high - low) / 2;
+      if (chunks[mid].key < key)
+      {
+         low = mid + 1;
+      }
+      else
+      {
+         high = mid;
+      }
+   }
+   return low;
+}
+
+void BitmapIntSet::toWords(const Chunk& chunk, unsigned long long* words)
+{
+   if (chunk.type == BITSET)
+   {
+      copy(chunk.words.begin(), chunk.words.end(), words);
+      return;
+   }
+
+   fill(words, words + WORDS_PER_CHUNK, 0ULL);
+   if (chunk.type == ARRAY)
+   {
+      for (size_t i = 0; i < chunk.low.size(); ++i)
+      {
+         words[chunk.low[i] / 64] |= 1ULL << (chunk.low[i] % 64);
+      }
+   }
+   else
+   {
+      for (size_t i = 0; i < chunk.low.size(); i += 2)
+      {
+         setRange(words, chunk.low[i], chunk.low[i] + chunk.low[i + 1]);
+      }
+   }
+}
+
+void BitmapIntSet::fromWords(Chunk& chunk, const unsigned long long* words)
+{
+   // Cardinality by popcount, one word (64 values) at a time
+   int cardinality = 0;
+   for (int w = 0; w < WORDS_PER_CHUNK; ++w)
+   {
+      cardinality += popcount64(words[w]);
+   }
+   chunk.cardinality = cardinality;
+
+   if (cardinality > ARRAY_MAX)
+   {
+      chunk.type = BITSET;
+      chunk.words.assign(words, words + WORDS_PER_CHUNK);
+      vector<unsigned short>().swap(chunk.low);
+   }
+   else
+   {
+      chunk.type = ARRAY;
+      vector<unsigned short> positions;
+      positions.reserve(cardinality);
+      for (int w = 0; w < WORDS_PER_CHUNK; ++w)
+      {
+         for (unsigned long long bits = words[w]; bits != 0;
+              bits &= bits - 1)
+         {
+            positions.push_back(
+               static_cast<unsigned short>(w * 64 + lowestBit(bits)));
+         }
+      }
+      chunk.low.swap(positions);
+      vector<unsigned long long>().swap(chunk.words);
+   }
+}
+
+void BitmapIntSet::expandRuns(Chunk& chunk)
+{
+   if (chunk.type == RUN)
+   {
+      unsigned long long words[WORDS_PER_CHUNK];
+      toWords(chunk, words);
+      fromWords(chunk, words);
+   }
+}
+
+bool BitmapIntSet::chunkContains(const Chunk& chunk, unsigned short low)
+{
+   if (chunk.type == ARRAY)
+   {
+      return binary_search(chunk.low.begin(), chunk.low.end(), low);
+   }
+   else if (chunk.type == BITSET)
+   {
+      return (chunk.words[low / 64] >> (low % 64)) & 1;
+   }
+
+   // RUN: locating the last run starting at or before low
+   int first = 0;
+   int last = static_cast<int>(chunk.low.size() / 2);
+   while (first < last)
+   {
+      int mid = first + (last - first) / 2;
+      if (chunk.low[2 * mid] <= low)
+      {
+         first = mid + 1;
+      }
+      else
+      {
+         last = mid;
+      }
+   }
+   if (first == 0)
+   {
+      return false;
+   }
+   return low - chunk.low[2 * (first - 1)] <= chunk.low[2 * (first - 1) + 1];
+}
+
+int BitmapIntSet::size() const
+{
+   return used;
+}
+
+bool BitmapIntSet::isEmpty() const
+{
+   return (used == 0);
+}
+
+bool BitmapIntSet::contains(int anInt) const
+{
+   unsigned u = toKeySpace(anInt);
+   int i = findChunk(u >> 16);
+   if (i == static_cast<int>(chunks.size()) || chunks[i].key != (u >> 16))
+   {
+      return false;
+   }
+   return chunkContains(chunks[i], static_cast<unsigned short>(u & 0xFFFF));
+}
+
+bool BitmapIntSet::isSubsetOf(const BitmapIntSet& otherIntSet) const
+{
+   // An empty set is a subset of any set; a larger set never is
+   if (isEmpty())
+   {
+      return true;
+   }
+   else if (used > otherIntSet.used)
+   {
+      return false;
+   }
+
+   unsigned long long mine[WORDS_PER_CHUNK];
+   unsigned long long theirs[WORDS_PER_CHUNK];
+   size_t j = 0;
+   for (size_t i = 0; i < chunks.size(); ++i)
+   {
+      const Chunk& a = chunks[i];
+      while (j < otherIntSet.chunks.size() &&
+             otherIntSet.chunks[j].key < a.key)
+      {
+         ++j;
+      }
+      if (j == otherIntSet.chunks.size() ||
+          otherIntSet.chunks[j].key != a.key ||
+          otherIntSet.chunks[j].cardinality < a.cardinality)
+      {
+         return false;
+      }
+
+      const Chunk& b = otherIntSet.chunks[j];
+      if (a.type == ARRAY)
+      {
+         for (size_t k = 0; k < a.low.size(); ++k)
+         {
+            if (!chunkContains(b, a.low[k]))
+            {
+               return false;
+            }
+         }
+      }
+      else
+      {
+         toWords(a, mine);
+         toWords(b, theirs);
+         for (int w = 0; w < WORDS_PER_CHUNK; ++w)
+         {
+            if (mine[w] & ~theirs[w])
+            {
+               return false;
+            }
+         }
+      }
+   }
+   return true;
+}
+
+void BitmapIntSet::DumpData(ostream& out) const
+{
+   const char* separator = "";
+   for (size_t i = 0; i < chunks.size(); ++i)
+   {
+      const Chunk& chunk = chunks[i];
+      if (chunk.type == ARRAY)
+      {
+         for (size_t k = 0; k < chunk.low.size(); ++k)
+         {
+            out << separator << fromKeySpace(chunk.key, chunk.low[k]);
+            separator = "  ";
+         }
+      }
+      else if (chunk.type == BITSET)
+      {
+         for (int w = 0; w < WORDS_PER_CHUNK; ++w)
+         {
+            for (unsigned long long bits = chunk.words[w]; bits != 0;
+                 bits &= bits - 1)
+            {
+               out << separator
+                   << fromKeySpace(chunk.key, w * 64 + lowestBit(bits));
+               separator = "  ";
+            }
+         }
+      }
+      else
+      {
+         for (size_t k = 0; k < chunk.low.size(); k += 2)
+         {
+            for (unsigned p = chunk.low[k];
+                 p <= unsigned(chunk.low[k]) + chunk.low[k + 1]; ++p)
+            {
+               out << separator << fromKeySpace(chunk.key, p);
+               separator = "  ";
+            }
+         }
+      }
+   }
+}
+
+bool BitmapIntSet::combineSparse(const Chunk& a, const Chunk& b,
+                                 SetOperation op, Chunk& result)
+{
+   if (a.type != ARRAY || (b.type != ARRAY && op == UNION))
+   {
+      return false;
+   }
+
+   vector<unsigned short> positions;
+   if (op == UNION)
+   {
+      positions.reserve(a.low.size() + b.low.size());
+      set_union(a.low.begin(), a.low.end(), b.low.begin(), b.low.end(),
+                back_inserter(positions));
+      if (static_cast<int>(positions.size()) > ARRAY_MAX)
+      {
+         unsigned long long words[WORDS_PER_CHUNK];
+         fill(words, words + WORDS_PER_CHUNK, 0ULL);
+         for (size_t i = 0; i < positions.size(); ++i)
+         {
+            words[positions[i] / 64] |= 1ULL << (positions[i] % 64);
+         }
+         fromWords(result, words);
+         return true;
+      }
+   }
+   else if (b.type == ARRAY)
+   {
+      positions.reserve(a.low.size());
+      if (op == INTERSECTION)
+      {
+         set_intersection(a.low.begin(), a.low.end(),
+                          b.low.begin(), b.low.end(),
+                          back_inserter(positions));
+      }
+      else
+      {
+         set_difference(a.low.begin(), a.low.end(),
+                        b.low.begin(), b.low.end(),
+                        back_inserter(positions));
+      }
+   }
+   else
+   {
+      // Filtering a's members by membership in b's bitset or runs
+      bool keep = (op == INTERSECTION);
+      positions.reserve(a.low.size());
+      for (size_t i = 0; i < a.low.size(); ++i)
+      {
+         if (chunkContains(b, a.low[i]) == keep)
+         {
+            positions.push_back(a.low[i]);
+         }
+      }
+   }
+
+   result.type = ARRAY;
+   result.cardinality = static_cast<int>(positions.size());
+   result.low.swap(positions);
+   return true;
+}
+
+BitmapIntSet BitmapIntSet::combine(const BitmapIntSet& otherIntSet,
+                                   SetOperation op) const
+{
+   BitmapIntSet result;
+   result.chunks.reserve(op == INTERSECTION ? chunks.size()
+                         : chunks.size() + otherIntSet.chunks.size());
+   unsigned long long wordsA[WORDS_PER_CHUNK];
+   unsigned long long wordsB[WORDS_PER_CHUNK];
+   size_t i = 0, j = 0;
+
+   while (i < chunks.size() || j < otherIntSet.chunks.size())
+   {
+      bool haveA = i < chunks.size();
+      bool haveB = j < otherIntSet.chunks.size();
+
+      if (haveA && (!haveB || chunks[i].key < otherIntSet.chunks[j].key))
+      {
+         // Key only in the invoking set
+         if (op != INTERSECTION)
+         {
+            result.chunks.push_back(chunks[i]);
+         }
+         ++i;
+      }
+      else if (!haveA || otherIntSet.chunks[j].key < chunks[i].key)
+      {
+         // Key only in otherIntSet
+         if (op == UNION)
+         {
+            result.chunks.push_back(otherIntSet.chunks[j]);
+         }
+         ++j;
+      }
+      else
+      {
+         // Key in both: combining the two chunks
+         Chunk chunk;
+         chunk.key = chunks[i].key;
+         if (!combineSparse(chunks[i], otherIntSet.chunks[j], op, chunk))
+         {
+            toWords(chunks[i], wordsA);
+            toWords(otherIntSet.chunks[j], wordsB);
+            for (int w = 0; w < WORDS_PER_CHUNK; ++w)
+            {
+               if (op == UNION)
+               {
+                  wordsA[w] |= wordsB[w];
+               }
+               else if (op == INTERSECTION)
+               {
+                  wordsA[w] &= wordsB[w];
+               }
+               else
+               {
+                  wordsA[w] &= ~wordsB[w];
+               }
+            }
+            fromWords(chunk, wordsA);
+         }
+         if (chunk.cardinality > 0)
+         {
+            result.chunks.push_back(move(chunk));
+         }
+         ++i;
+         ++j;
+      }
+   }
+
+   for (size_t k = 0; k < result.chunks.size(); ++k)
+   {
+      result.used += result.chunks[k].cardinality;
+   }
+   return result;
+}
+
+BitmapIntSet BitmapIntSet::unionWith(const BitmapIntSet& otherIntSet) const
+{
+   return combine(otherIntSet, UNION);
+}
+
+BitmapIntSet BitmapIntSet::intersect(const BitmapIntSet& otherIntSet) const
+{
+   return combine(otherIntSet, INTERSECTION);
+}
+
+BitmapIntSet BitmapIntSet::subtract(const BitmapIntSet& otherIntSet) const
+{
+   return combine(otherIntSet, DIFFERENCE);
+}
+
+size_t BitmapIntSet::memoryUsage() const
+{
+   size_t bytes = sizeof(*this) + chunks.capacity() * sizeof(Chunk);
+   for (size_t i = 0; i < chunks.size(); ++i)
+   {
+      bytes += chunks[i].low.capacity() * sizeof(unsigned short);
+      bytes += chunks[i].words.capacity() * sizeof(unsigned long long);
+   }
+   return bytes;
+}
+
+void BitmapIntSet::reset()
+{
+   vector<Chunk>().swap(chunks);
+   used = 0;
+}
+
+bool BitmapIntSet::add(int anInt)
+{
+   unsigned u = toKeySpace(anInt);
+   unsigned key = u >> 16;
+   unsigned short low = static_cast<unsigned short>(u & 0xFFFF);
+   int i = findChunk(key);
+
+   // First member of a new chunk
+   if (i == static_cast<int>(chunks.size()) || chunks[i].key != key)
+   {
+      Chunk chunk;
+      chunk.key = key;
+      chunk.type = ARRAY;
+      chunk.cardinality = 1;
+      chunk.low.push_back(low);
+      chunks.insert(chunks.begin() + i, chunk);
+      ++used;
+      return true;
+   }
+
+   Chunk& chunk = chunks[i];
+   if (chunk.type == RUN)
+   {
+      if (chunkContains(chunk, low))
+      {
+         return false;
+      }
+      expandRuns(chunk);
+   }
+
+   if (chunk.type == ARRAY)
+   {
+      vector<unsigned short>::iterator pos =
+         lower_bound(chunk.low.begin(), chunk.low.end(), low);
+      if (pos != chunk.low.end() && *pos == low)
+      {
+         return false;
+      }
+      if (chunk.cardinality < ARRAY_MAX)
+      {
+         chunk.low.insert(pos, low);
+      }
+      else
+      {
+         // Full ARRAY chunk becomes a BITSET chunk
+         chunk.words.assign(WORDS_PER_CHUNK, 0ULL);
+         for (size_t k = 0; k < chunk.low.size(); ++k)
+         {
+            chunk.words[chunk.low[k] / 64] |= 1ULL << (chunk.low[k] % 64);
+         }
+         chunk.words[low / 64] |= 1ULL << (low % 64);
+         vector<unsigned short>().swap(chunk.low);
+         chunk.type = BITSET;
+      }
+   }
+   else
+   {
+      unsigned long long bit = 1ULL << (low % 64);
+      if (chunk.words[low / 64] & bit)
+      {
+         return false;
+      }
+      chunk.words[low / 64] |= bit;
+   }
+
+   ++chunk.cardinality;
+   ++used;
+   return true;
+}
+
+bool BitmapIntSet::remove(int anInt)
+{
+   unsigned u = toKeySpace(anInt);
+   unsigned key = u >> 16;
+   unsigned short low = static_cast<unsigned short>(u & 0xFFFF);
+   int i = findChunk(key);
+
+   if (i == static_cast<int>(chunks.size()) || chunks[i].key != key ||
+       !chunkContains(chunks[i], low))
+   {
+      return false;
+   }
+
+   Chunk& chunk = chunks[i];
+   expandRuns(chunk);
+   if (chunk.type == ARRAY)
+   {
+      chunk.low.erase(lower_bound(chunk.low.begin(), chunk.low.end(), low));
+      --chunk.cardinality;
+   }
+   else
+   {
+      chunk.words[low / 64] &= ~(1ULL << (low % 64));
+      --chunk.cardinality;
+      if (chunk.cardinality <= ARRAY_MAX)
+      {
+         // Back under the threshold: BITSET chunk becomes ARRAY chunk
+         vector<unsigned long long> words;
+         words.swap(chunk.words);
+         fromWords(chunk, &words[0]);
+      }
+   }
+   --used;
+
+   if (chunk.cardinality == 0)
+   {
+      chunks.erase(chunks.begin() + i);
+   }
+   return true;
+}
+
+void BitmapIntSet::runOptimize()
+{
+   unsigned long long words[WORDS_PER_CHUNK];
+   for (size_t i = 0; i < chunks.size(); ++i)
+   {
+      Chunk& chunk = chunks[i];
+      if (chunk.type == RUN)
+      {
+         continue;
+      }
+
+      // Collecting the runs of the chunk, in (start, length) pairs
+      vector<unsigned short> runs;
+      if (chunk.type == ARRAY)
+      {
+         for (size_t k = 0; k < chunk.low.size(); ++k)
+         {
+            if (k > 0 && chunk.low[k] == chunk.low[k - 1] + 1)
+            {
+               ++runs.back();
+            }
+            else
+            {
+               runs.push_back(chunk.low[k]);
+               runs.push_back(0);
+            }
+         }
+      }
+      else
+      {
+         toWords(chunk, words);
+         int position = 0;
+         while (position < WORDS_PER_CHUNK * 64)
+         {
+            if (!((words[position / 64] >> (position % 64)) & 1))
+            {
+               ++position;
+               continue;
+            }
+            int start = position;
+            while (position < WORDS_PER_CHUNK * 64 &&
+                   ((words[position / 64] >> (position % 64)) & 1))
+            {
+               ++position;
+            }
+            runs.push_back(static_cast<unsigned short>(start));
+            runs.push_back(static_cast<unsigned short>(position - 1 - start));
+         }
+      }
+
+      // Converting only if the runs take less space
+      size_t currentBytes = (chunk.type == ARRAY)
+                            ? chunk.low.size() * sizeof(unsigned short)
+                            : WORDS_PER_CHUNK * sizeof(unsigned long long);
+      if (runs.size() * sizeof(unsigned short) < currentBytes)
+      {
+         chunk.type = RUN;
+         chunk.low.swap(runs);
+         vector<unsigned long long>().swap(chunk.words);
+      }
+   }
+}
+
+bool operator==(const BitmapIntSet& is1, const BitmapIntSet& is2)
+{
+   // Same size and one a subset of the other means same elements
+   return is1.size() == is2.size() && is1.isSubsetOf(is2);
+}
@@ -0,0 +1,149 @@
+// FILE: BitmapIntSet.h - header file for BitmapIntSet class
+// CLASS PROVIDED: BitmapIntSet (a container class for a set of
+//                 int values, stored as a compressed bitmap)
+//
+// BitmapIntSet offers the same operations as IntSet (see IntSet.h)
+// but stores its elements the way "roaring" bitmaps do: the int
+// range is cut into chunks of 65536 consecutive values, and each
+// non-empty chunk is kept in whichever container suits it:
+//   ARRAY  - a sorted array of the members' low 16 bits (2 bytes
+//            per member), used for chunks of up to 4096 members;
+//   BITSET - 1024 64-bit words, one bit per value (8 KB flat), used
+//            for chunks of more than 4096 members;
+//   RUN    - a sorted list of [start, start + length] runs (4 bytes
+//            per run), used (after runOptimize) for chunks whose
+//            members form few long runs.
+// Dense ranges of small integers therefore cost at most 1 bit per
+// value (and far less once run-optimized) instead of 4+ bytes.
+//
+// CONSTRUCTOR
+//   BitmapIntSet()
+//     Post: The invoking BitmapIntSet is initialized to an empty
+//           BitmapIntSet.
+//
+// CONSTANT MEMBER FUNCTIONS (ACCESSORS)
+//   int size() const
+//     Pre:  (none)
+//     Post: Number of elements in the invoking BitmapIntSet is
+//           returned.
+//   bool isEmpty() const
+//     Pre:  (none)
+//     Post: True is returned if the invoking BitmapIntSet has no
+//           elements, otherwise false is returned.
+//   bool contains(int anInt) const
+//     Pre:  (none)
+//     Post: true is returned if the invoking BitmapIntSet has anInt
+//           as an element, otherwise false is returned.
+//   bool isSubsetOf(const BitmapIntSet& otherIntSet) const
+//     Pre:  (none)
+//     Post: True is returned if all elements of the invoking
+//           BitmapIntSet are also elements of otherIntSet, otherwise
+//           false is returned (an empty set is a subset of any set).
+//   void DumpData(std::ostream& out) const
+//     Pre:  (none)
+//     Post: Contents of the invoking BitmapIntSet have been inserted
+//           into out, in ascending order, with 2 spaces separating
+//           one item from another if there are 2 or more items.
+//   BitmapIntSet unionWith(const BitmapIntSet& otherIntSet) const
+//   BitmapIntSet intersect(const BitmapIntSet& otherIntSet) const
+//   BitmapIntSet subtract(const BitmapIntSet& otherIntSet) const
+//     Pre:  (none)
+//     Post: A BitmapIntSet representing the union, intersection or
+//           difference (respectively) of the invoking BitmapIntSet
+//           and otherIntSet is returned.
+//     Note: Chunks are combined pairwise; whenever either chunk is a
+//           BITSET or RUN the combination is done 64 values at a
+//           time with word-wide OR/AND/AND-NOT and the result's size
+//           is recounted with popcount.
+//   std::size_t memoryUsage() const
+//     Pre:  (none)
+//     Post: The number of bytes the invoking BitmapIntSet occupies
+//           (object plus dynamic memory it owns) is returned.
+//
+// MODIFICATION MEMBER FUNCTIONS (MUTATORS)
+//   void reset()
+//     Pre:  (none)
+//     Post: The invoking BitmapIntSet is reset to become empty.
+//   bool add(int anInt)
+//     Pre:  (none)
+//     Post: If contains(anInt) returns false, anInt has been added
+//           to the invoking BitmapIntSet and true is returned,
+//           otherwise the invoking BitmapIntSet is unchanged and
+//           false is returned.
+//   bool remove(int anInt)
+//     Pre:  (none)
+//     Post: If contains(anInt) returns true, anInt has been removed
+//           from the invoking BitmapIntSet and true is returned,
+//           otherwise the invoking BitmapIntSet is unchanged and
+//           false is returned.
+//   void runOptimize()
+//     Pre:  (none)
+//     Post: Every chunk that is smaller as a RUN container has been
+//           converted to one; the elements are unchanged.
+//     Note: A RUN chunk that is later added to or removed from goes
+//           back to being an ARRAY or BITSET chunk.
+//
+// NON-MEMBER FUNCTIONS
+//   bool operator==(const BitmapIntSet& is1, const BitmapIntSet& is2)
+//     Pre:  (none)
+//     Post: True is returned if is1 and is2 have the same elements,
+//           otherwise false is returned.
+//
+// VALUE SEMANTICS
+//   Assignment and the copy constructor may be used with
+//   BitmapIntSet objects.
+
+#ifndef BITMAP_INT_SET_H
+#define BITMAP_INT_SET_H
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+class BitmapIntSet
+{
+public:
+   BitmapIntSet();
+   int size() const;
+   bool isEmpty() const;
+   bool contains(int anInt) const;
+   bool isSubsetOf(const BitmapIntSet& otherIntSet) const;
+   void DumpData(std::ostream& out) const;
+   BitmapIntSet unionWith(const BitmapIntSet& otherIntSet) const;
+   BitmapIntSet intersect(const BitmapIntSet& otherIntSet) const;
+   BitmapIntSet subtract(const BitmapIntSet& otherIntSet) const;
+   std::size_t memoryUsage() const;
+   void reset();
+   bool add(int anInt);
+   bool remove(int anInt);
+   void runOptimize();
+
+private:
+   enum ContainerType { ARRAY, BITSET, RUN };
+   enum SetOperation { UNION, INTERSECTION, DIFFERENCE };
+   struct Chunk
+   {
+      unsigned key;                    // high 16 bits (sign-flipped)
+      ContainerType type;
+      int cardinality;                 // # of members in this chunk
+      std::vector<unsigned short> low; // ARRAY: members' low bits;
+                                       // RUN: start, length pairs
+      std::vector<unsigned long long> words;  // BITSET: 1024 words
+   };
+   std::vector<Chunk> chunks;          // sorted by key
+   int used;
+
+   int findChunk(unsigned key) const;
+   BitmapIntSet combine(const BitmapIntSet& otherIntSet,
+                        SetOperation op) const;
+   static void toWords(const Chunk& chunk, unsigned long long* words);
+   static void fromWords(Chunk& chunk, const unsigned long long* words);
+   static void expandRuns(Chunk& chunk);
+   static bool chunkContains(const Chunk& chunk, unsigned short low);
+   static bool combineSparse(const Chunk& a, const Chunk& b,
+                             SetOperation op, Chunk& result);
+};
+
+bool operator==(const BitmapIntSet& is1, const BitmapIntSet& is2);
+
+#endif
@@ -0,0 +1,284 @@
+// FILE: ConcurrentIntSet.cpp - implementation file for the
+//       ConcurrentIntSet class (See ConcurrentIntSet.h for
+//       documentation.)
+// INVARIANT for the ConcurrentIntSet class:
+// (1) current points to the latest snapshot: a malloc'ed block whose
+//     element 0 holds the # of elements n and whose elements 1 .. n
+//     hold the distinct values of the set in strictly ascending
+//     order. A published snapshot is never modified.
+// (2) retired holds every snapshot that has been replaced but not yet
+//     freed, each with the global epoch at the time it was replaced;
+//     it is only touched while writerLock is held.
+// (3) Each reading thread owns one slot of readerSlots. While it is
+//     inside a constant member function (see ReadGuard) its slot
+//     holds the global epoch it read on entry (never 0), otherwise 0.
+// (4) A snapshot retired at epoch R is freed only when no slot holds
+//     a nonzero epoch <= R. A reader whose slot holds e > R read the
+//     global epoch after it was advanced past R, which is after the
+//     snapshot's replacement was published, so it can only have
+//     loaded a newer snapshot. A reader whose slot store comes after
+//     the writer's scan of the slots also loads the newer snapshot
+//     (both sides use sequentially consistent atomics).
+//
+// DOCUMENTATION for private members:
+//   class ReadGuard
+//     Constructing one announces the calling thread as a reader (its
+//     slot is set to the global epoch); destroying it clears the slot.
+//     The first ReadGuard made by a thread claims the thread's slot,
+//     which a thread_local object gives back when the thread ends;
+//     if all MAX_READER_THREADS slots are taken an error message is
+//     displayed and the program unconditionally terminated.
+//   static int* newSnapshot(int n)
+//     Pre:  n >= 0
+//     Post: A new snapshot block with room for n elements, and element
+//           0 set to n, is returned (allocation failure terminates the
+//           program with an error message, as in IntSet).
+//   void publish(int* snapshot)
+//     Pre:  writerLock is held; snapshot is a complete new snapshot.
+//     Post: snapshot has become current, the old one has been retired
+//           and the global epoch advanced; reclaim() has been called.
+//   void reclaim()
+//     Pre:  writerLock is held.
+//     Post: Every retired snapshot no reader can still be using has
+//           been freed.
+
+#include "ConcurrentIntSet.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+using namespace std;
+
+namespace
+{
+   // One cache line per slot so readers don't write to each other's
+   // lines
+   struct alignas(64) ReaderSlot
+   {
+      atomic<unsigned long> epoch;
+      atomic<bool> taken;
+   };
+
+   ReaderSlot readerSlots[ConcurrentIntSet::MAX_READER_THREADS];
+   atomic<unsigned long> globalEpoch(1);
+
+   // Gives a thread's slot back when the thread ends
+   struct SlotOwner
+   {
+      ReaderSlot* slot;
+      SlotOwner() : slot(NULL) {}
+      ~SlotOwner()
+      {
+         if (slot != NULL)
+         {
+            slot->epoch.store(0);
+            slot->taken.store(false);
+         }
+      }
+   };
+
+   thread_local SlotOwner slotOwner;
+
+   ReaderSlot* claimSlot()
+   {
+      for (int i = 0; i < ConcurrentIntSet::MAX_READER_THREADS; i++)
+      {
+         bool expected = false;
+         if (!readerSlots[i].taken.load(memory_order_relaxed)
+             && readerSlots[i].taken.compare_exchange_strong(expected,
+                                                              true))
+         {
+            return &readerSlots[i];
+         }
+      }
+      cerr << "ConcurrentIntSet: more than "
+           << ConcurrentIntSet::MAX_READER_THREADS
+           << " reader threads" << endl;
+      exit(EXIT_FAILURE);
+   }
+}
+
+class ConcurrentIntSet::ReadGuard
+{
+public:
+   ReadGuard()
+   {
+      if (slotOwner.slot == NULL)
+      {
+         slotOwner.slot = claimSlot();
+      }
+      slotOwner.slot->epoch.store(globalEpoch.load());
+   }
+   ~ReadGuard()
+   {
+      slotOwner.slot->epoch.store(0, memory_order_release);
+   }
+};
+
+int* ConcurrentIntSet::newSnapshot(int n)
+{
+   int* snapshot = static_cast<int*>(malloc((n + 1) * sizeof(int)));
+   if (snapshot == NULL)
+   {
+      cerr << "ConcurrentIntSet: allocation of " << n
+           << " ints failed" << endl;
+      exit(EXIT_FAILURE);
+   }
+   snapshot[0] = n;
+   return snapshot;
+}
+
+void ConcurrentIntSet::publish(int* snapshot)
+{
+   int* old = current.load();
+   current.store(snapshot);
+   retired.push_back(make_pair(old, globalEpoch.fetch_add(1)));
+   reclaim();
+}
+
+void ConcurrentIntSet::reclaim()
+{
+   // The oldest epoch any reader is in right now (0 if none)
+   unsigned long oldest = 0;
+   for (int i = 0; i < MAX_READER_THREADS; i++)
+   {
+      unsigned long epoch = readerSlots[i].epoch.load();
+      if (epoch != 0 && (oldest == 0 || epoch < oldest))
+      {
+         oldest = epoch;
+      }
+   }
+
+   size_t kept = 0;
+   for (size_t i = 0; i < retired.size(); i++)
+   {
+      if (oldest == 0 || retired[i].second < oldest)
+      {
+         free(retired[i].first);
+      }
+      else
+      {
+         retired[kept++] = retired[i];
+      }
+   }
+   retired.resize(kept);
+}
+
+ConcurrentIntSet::ConcurrentIntSet() : current(newSnapshot(0))
+{
+}
+
+ConcurrentIntSet::~ConcurrentIntSet()
+{
+   free(current.load());
+   for (size_t i = 0; i < retired.size(); i++)
+   {
+      free(retired[i].first);
+   }
+}
+
+int ConcurrentIntSet::size() const
+{
+   ReadGuard guard;
+   return current.load()[0];
+}
+
+bool ConcurrentIntSet::isEmpty() const
+{
+   return size() == 0;
+}
+
+bool ConcurrentIntSet::contains(int anInt) const
+{
+   ReadGuard guard;
+   const int* snapshot = current.load();
+   return binary_search(snapshot + 1, snapshot + 1 + snapshot[0], anInt);
+}
+
+void ConcurrentIntSet::DumpData(ostream& out) const
+{
+   ReadGuard guard;
+   const int* snapshot = current.load();
+   for (int i = 1; i <= snapshot[0]; ++i)
+   {
+      if (i > 1)
+         out << "  ";
+      out << snapshot[i];
+   }
+}
+
+void ConcurrentIntSet::reset()
+{
+   lock_guard<mutex> lock(writerLock);
+   publish(newSnapshot(0));
+}
+
+bool ConcurrentIntSet::add(int anInt)
+{
+   lock_guard<mutex> lock(writerLock);
+
+   // Writers are serialized, so current can't change under us
+   const int* old = current.load();
+   const int* begin = old + 1;
+   const int* end = begin + old[0];
+   const int* pos = lower_bound(begin, end, anInt);
+   if (pos != end && *pos == anInt)
+   {
+      return false;
+   }
+
+   // New snapshot: the old elements with anInt slotted in at pos
+   int* snapshot = newSnapshot(old[0] + 1);
+   memcpy(snapshot + 1, begin, (pos - begin) * sizeof(int));
+   snapshot[1 + (pos - begin)] = anInt;
+   memcpy(snapshot + 2 + (pos - begin), pos, (end - pos) * sizeof(int));
+   publish(snapshot);
+
+   return true;
+}
+
+bool ConcurrentIntSet::remove(int anInt)
+{
+   lock_guard<mutex> lock(writerLock);
+
+   const int* old = current.load();
+   const int* begin = old + 1;
+   const int* end = begin + old[0];
+   const int* pos = lower_bound(begin, end, anInt);
+   if (pos == end || *pos != anInt)
+   {
+      return false;
+   }
+
+   int* snapshot = newSnapshot(old[0] - 1);
+   memcpy(snapshot + 1, begin, (pos - begin) * sizeof(int));
+   memcpy(snapshot + 1 + (pos - begin), pos + 1,
+          (end - pos - 1) * sizeof(int));
+   publish(snapshot);
+
+   return true;
+}
+
+int ConcurrentIntSet::addAll(const int* first, const int* last)
+{
+   // Sorting and deduplicating the input outside the lock
+   vector<int> incoming(first, last);
+   sort(incoming.begin(), incoming.end());
+   incoming.erase(unique(incoming.begin(), incoming.end()), incoming.end());
+
+   lock_guard<mutex> lock(writerLock);
+
+   const int* old = current.load();
+   int* snapshot = newSnapshot(old[0] + int(incoming.size()));
+   int* end = set_union(old + 1, old + 1 + old[0], incoming.begin(),
+                        incoming.end(), snapshot + 1);
+   int added = int(end - (snapshot + 1)) - old[0];
+   if (added == 0)
+   {
+      free(snapshot);
+      return 0;
+   }
+   snapshot[0] = old[0] + added;
+   publish(snapshot);
+
+   return added;
+}
@@ -0,0 +1,122 @@
+// FILE: ConcurrentIntSet.h - header file for ConcurrentIntSet class
+// CLASS PROVIDED: ConcurrentIntSet (a container class for a set of
+//                 int values that may be shared by many threads)
+//
+// ConcurrentIntSet is meant for read-mostly sharing: any number of
+// threads may call the constant member functions (contains above all)
+// at the same time as each other and as the mutators, without locks.
+//   - The elements live in an immutable, sorted snapshot array. A
+//     reader announces the current epoch, loads the pointer to the
+//     current snapshot and binary-searches it; it never waits for a
+//     writer or another reader (contains is wait-free, except for the
+//     first call on each thread, which claims a reader slot).
+//   - Writers (add, remove, addAll, reset) are serialized by a mutex.
+//     Each one copies the current snapshot with its change applied,
+//     publishes the copy with a single atomic store, and retires the
+//     old snapshot. A retired snapshot is freed only once every
+//     reader that could still be looking at it has left (epoch-based
+//     reclamation), so readers never see freed memory.
+// A write therefore costs O(size()) (use addAll to apply many values
+// with one copy); reads cost O(log size()).
+//
+// CONSTANT
+//   static const int MAX_READER_THREADS = ____
+//     The highest # of threads that may be reading ConcurrentIntSets
+//     at the same time (a thread's reader slot is given back when the
+//     thread ends).
+//
+// CONSTRUCTOR and DESTRUCTOR
+//   ConcurrentIntSet()
+//     Post: The invoking ConcurrentIntSet is initialized to an empty
+//           ConcurrentIntSet.
+//   ~ConcurrentIntSet()
+//     Pre:  No other thread is using the invoking ConcurrentIntSet.
+//     Post: All snapshot arrays (current and retired) are freed.
+//
+// CONSTANT MEMBER FUNCTIONS (ACCESSORS) - safe to call concurrently
+//   int size() const
+//     Pre:  (none)
+//     Post: Number of elements in the invoking ConcurrentIntSet (as of
+//           the latest snapshot) is returned.
+//   bool isEmpty() const
+//     Pre:  (none)
+//     Post: True is returned if the invoking ConcurrentIntSet has no
+//           elements, otherwise false is returned.
+//   bool contains(int anInt) const
+//     Pre:  (none)
+//     Post: true is returned if anInt is an element of the latest
+//           snapshot of the invoking ConcurrentIntSet, otherwise false
+//           is returned.
+//   void DumpData(std::ostream& out) const
+//     Pre:  (none)
+//     Post: Contents of one snapshot of the invoking ConcurrentIntSet
+//           have been inserted into out in ascending order, with 2
+//           spaces separating one item from another if there are 2
+//           or more items.
+//
+// MODIFICATION MEMBER FUNCTIONS (MUTATORS) - serialized with each other
+//   void reset()
+//     Pre:  (none)
+//     Post: The invoking ConcurrentIntSet is reset to become empty.
+//   bool add(int anInt)
+//     Pre:  (none)
+//     Post: If contains(anInt) returns false, anInt has been added to
+//           the invoking ConcurrentIntSet and true is returned,
+//           otherwise the ConcurrentIntSet is unchanged and false is
+//           returned.
+//   bool remove(int anInt)
+//     Pre:  (none)
+//     Post: If contains(anInt) returns true, anInt has been removed
+//           from the invoking ConcurrentIntSet and true is returned,
+//           otherwise the ConcurrentIntSet is unchanged and false is
+//           returned.
+//   int addAll(const int* first, const int* last)
+//     Pre:  [first, last) is a valid range of ints.
+//     Post: Every value in [first, last) is an element of the invoking
+//           ConcurrentIntSet, and the number of values that were newly
+//           added is returned. Readers see either none or all of the
+//           new values (one snapshot is published for the whole range).
+//
+// VALUE SEMANTICS
+//   ConcurrentIntSet objects can't be copied or assigned.
+
+#ifndef CONCURRENT_INT_SET_H
+#define CONCURRENT_INT_SET_H
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+class ConcurrentIntSet
+{
+public:
+   static const int MAX_READER_THREADS = 256;
+   ConcurrentIntSet();
+   ConcurrentIntSet(const ConcurrentIntSet&) = delete;
+   ConcurrentIntSet& operator=(const ConcurrentIntSet&) = delete;
+   ~ConcurrentIntSet();
+   int size() const;
+   bool isEmpty() const;
+   bool contains(int anInt) const;
+   void DumpData(std::ostream& out) const;
+   void reset();
+   bool add(int anInt);
+   bool remove(int anInt);
+   int addAll(const int* first, const int* last);
+
+private:
+   // A snapshot is one malloc'ed block of ints: snapshot[0] holds the
+   // # of elements n, snapshot[1] .. snapshot[n] the elements (sorted)
+   std::atomic<int*> current;
+   std::mutex writerLock;
+   std::vector<std::pair<int*, unsigned long> > retired;
+
+   class ReadGuard;
+   static int* newSnapshot(int n);
+   void publish(int* snapshot);
+   void reclaim();
+};
+
+#endif
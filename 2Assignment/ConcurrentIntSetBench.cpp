@@ -0,0 +1,159 @@
+// FILE: ConcurrentIntSetBench.cpp
+//       A reader-scaling benchmark for ConcurrentIntSet.
+//       A set of 64K values is shared by 1, 2, 4, ... 64 reader
+//       threads calling contains() on random values, while one writer
+//       thread adds or removes a value every 100 microseconds. Each
+//       configuration runs for a fixed time and the total lookups per
+//       second are written to cout for
+//          (1) a SORTED IntSet guarded by one std::mutex (every
+//              contains, add and remove takes the lock), and
+//          (2) a ConcurrentIntSet (lock-free readers).
+//       NOTE: Readers can only scale up to the # of hardware threads
+//             the machine has; beyond that the figures show how well
+//             each variant copes with oversubscription.
+
+#include "ConcurrentIntSet.h"
+#include "IntSet.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+const int SET_SIZE = 1 << 16;
+const int KEY_RANGE = 2 * SET_SIZE;   // about half the lookups hit
+const int RUN_MS = 300;
+
+// A SORTED IntSet behind one mutex: the "global lock" baseline
+class LockedIntSet
+{
+public:
+   LockedIntSet() : set(SET_SIZE, IntSet::SORTED) {}
+   bool contains(int anInt)
+   {
+      lock_guard<mutex> guard(lock);
+      return set.contains(anInt);
+   }
+   bool add(int anInt)
+   {
+      lock_guard<mutex> guard(lock);
+      return set.add(anInt);
+   }
+   bool remove(int anInt)
+   {
+      lock_guard<mutex> guard(lock);
+      return set.remove(anInt);
+   }
+private:
+   mutex lock;
+   IntSet set;
+};
+
+// PROTOTYPES for functions used by this benchmark program:
+
+template <class SetType>
+double lookups_per_second(SetType& set, int readers);
+// Pre:  readers >= 1; set holds the even values 0 .. 2*SET_SIZE-2.
+// Post: readers threads have looked up random values in set for
+//       RUN_MS milliseconds while one writer added and removed odd
+//       values; the total # of lookups per second is returned, and
+//       set holds the same values as before.
+
+int main()
+{
+   const int READERS[] = { 1, 2, 4, 8, 16, 32, 64 };
+   const int NUM_READERS = sizeof(READERS) / sizeof(READERS[0]);
+
+   LockedIntSet locked;
+   ConcurrentIntSet concurrent;
+   vector<int> values(SET_SIZE);
+   for (int i = 0; i < SET_SIZE; ++i)
+   {
+      values[i] = 2 * i;
+      locked.add(values[i]);
+   }
+   concurrent.addAll(&values[0], &values[0] + SET_SIZE);
+
+   cout << "hardware threads: " << thread::hardware_concurrency() << endl;
+   cout << setw(8) << "readers" << setw(16) << "mutex Mops/s"
+        << setw(18) << "concurrent Mops/s" << setw(10) << "speedup"
+        << endl;
+   for (int i = 0; i < NUM_READERS; ++i)
+   {
+      double mutex_rate = lookups_per_second(locked, READERS[i]);
+      double concurrent_rate = lookups_per_second(concurrent, READERS[i]);
+      cout << setw(8) << READERS[i] << fixed << setprecision(2)
+           << setw(16) << mutex_rate / 1e6
+           << setw(18) << concurrent_rate / 1e6
+           << setw(9) << concurrent_rate / mutex_rate << "x" << endl;
+   }
+
+   return EXIT_SUCCESS;
+}
+
+template <class SetType>
+double lookups_per_second(SetType& set, int readers)
+{
+   atomic<bool> go(false), stop(false);
+   atomic<long> total(0);
+   vector<thread> threads;
+
+   for (int r = 0; r < readers; ++r)
+   {
+      threads.push_back(thread([&set, &go, &stop, &total, r]()
+      {
+         minstd_rand rng(r + 1);
+         long lookups = 0, found = 0;
+         while (!go.load())
+            this_thread::yield();
+         while (!stop.load(memory_order_relaxed))
+         {
+            // Checking the stop flag once per 64 lookups
+            for (int k = 0; k < 64; ++k)
+               found += set.contains(int(rng() % KEY_RANGE));
+            lookups += 64;
+         }
+         total += lookups + (found < 0);
+      }));
+   }
+
+   // The writer: one add or remove of an odd value every 100 us, all
+   // undone by the end so each run starts from the same set
+   thread writer([&set, &go, &stop]()
+   {
+      int next = 1;
+      bool adding = true;
+      while (!go.load())
+         this_thread::yield();
+      while (!stop.load())
+      {
+         if (adding)
+            set.add(next);
+         else
+            set.remove(next);
+         adding = !adding;
+         if (adding)
+            next = (next + 2) % KEY_RANGE;
+         this_thread::sleep_for(chrono::microseconds(100));
+      }
+      if (!adding)
+         set.remove(next);
+   });
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   go.store(true);
+   this_thread::sleep_for(chrono::milliseconds(RUN_MS));
+   stop.store(true);
+   for (size_t t = 0; t < threads.size(); ++t)
+      threads[t].join();
+   double seconds = chrono::duration<double>(chrono::steady_clock::now()
+                                             - start).count();
+   writer.join();
+
+   return total.load() / seconds;
+}
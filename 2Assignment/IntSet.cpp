@@ -5,9 +5,13 @@
 // (1) Distinct int values of the IntSet are stored in a 1-D,
 //     dynamic array whose size is stored in member variable
 //     capacity; the member variable data references the array.
-// (2) The distinct int value with earliest membership is stored
-//     in data[0], the distinct int value with the 2nd-earliest
-//     membership is stored in data[1], and so on.
+//     Since int is trivially copyable, the array is managed with
+//     malloc/realloc/free (see allocate and resize) so it can be
+//     grown in place or relocated with a single block copy.
+// (2) When mode is INSERTION_ORDER, the distinct int value with
+//     earliest membership is stored in data[0], the distinct int
+//     value with the 2nd-earliest membership is stored in data[1],
+//     and so on.
 //     Note: No "prior membership" information is tracked; i.e.,
 //           if an int value that was previously a member (but its
 //           earlier membership ended due to removal) becomes a
@@ -18,6 +22,10 @@
 //           existing member (such as through the add operation)
 //           has no effect on the "membership timing" of that int
 //           value.
+// (3) When mode is SORTED, the distinct int values are stored in
+//     strictly ascending order (data[0] < data[1] < ... <
+//     data[used - 1]), so membership can be decided by binary
+//     search.
 // (4) The # of distinct int values the IntSet currently contains
 //     is stored in the member variable used.
 // (5) Except when the IntSet is empty (used == 0), ALL elements
@@ -40,6 +48,10 @@
 //           the data array and used (if properly initialized and
 //           maintained) should tell which elements of the data
 //           array are actually relevant.
+// (7) An IntSet that has been moved from owns no dynamic array: data
+//     is NULL and capacity (and used) is 0. resize() (thus add,
+//     reserve and shrinkToFit) and reset() accept that state, since
+//     realloc(NULL, n) and free(NULL) are well-defined.
 //
 // DOCUMENTATION for private member (helper) function:
 //   void resize(int new_capacity)
@@ -70,12 +82,74 @@
 //           If reallocation of dynamic array is unsuccessful, an
 //           error message to the effect is displayed and the
 //           program unconditionally terminated.
+//           Each call increments the count of reallocations.
+//   void grow()
+//     Pre:  (none)
+//     Post: The capacity of the invoking IntSet has been resized to
+//           growth * capacity + 1, clamped to INT_MAX and to at least
+//           capacity + 1 (the double product is never converted to
+//           int unless it fits). If the capacity is already INT_MAX,
+//           an error message to the effect is displayed and the
+//           program unconditionally terminated.
+//   static int* allocate(int new_capacity)
+//     Pre:  new_capacity >= 1
+//     Post: A pointer to a new (malloc'ed) dynamic array of
+//           new_capacity ints is returned. If allocation is
+//           unsuccessful, an error message to the effect is
+//           displayed and the program unconditionally terminated.
+//   int lowerBound(int anInt) const
+//     Pre:  mode is SORTED.
+//     Post: The index of the first element of data[0] through
+//           data[used - 1] that is not less than anInt is returned
+//           (used is returned if there is no such element).
+//   IntSet sortedUnion(const IntSet& otherIntSet) const
+//   IntSet sortedIntersect(const IntSet& otherIntSet) const
+//   IntSet sortedSubtract(const IntSet& otherIntSet) const
+//     Pre:  Both the invoking IntSet and otherIntSet are SORTED.
+//     Post: Same as unionWith, intersect and subtract respectively;
+//           the result is built by one merge pass over both data
+//           arrays (see IntSetKernels.h) into a SORTED IntSet whose
+//           capacity is set once to the largest size the result could
+//           have.
+//   void unionInPlace(const IntSet& otherIntSet)
+//   void intersectInPlace(const IntSet& otherIntSet)
+//   void subtractInPlace(const IntSet& otherIntSet)
+//     Pre:  &otherIntSet != this
+//     Post: The invoking IntSet has become its union, intersection or
+//           difference (respectively) with otherIntSet, computed in
+//           its own dynamic array (used by the && overloads of
+//           unionWith, intersect and subtract).
+//           unionInPlace counts the union's elements first, so it
+//           reallocates at most once, and only if the union can't fit
+//           in the current capacity; the other two never allocate.
+//           Elements keep their relative order.
 
 #include "IntSet.h"
+#include "IntSetKernels.h"
+#include <algorithm>
 #include <iostream>
 #include <cassert>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
 using namespace std;
 
+constexpr double IntSet::DEFAULT_GROWTH_FACTOR;
+
+int* IntSet::allocate(int new_capacity)
+{
+   int* new_data = static_cast<int*>(malloc(new_capacity * sizeof(int)));
+   if (new_data == NULL)
+   {
+      cerr << "IntSet: allocation of " << new_capacity
+           << " ints failed" << endl;
+      exit(EXIT_FAILURE);
+   }
+   return new_data;
+}
+
 void IntSet::resize(int new_capacity)
 {
    // Validating new capacity value
@@ -92,25 +166,63 @@ void IntSet::resize(int new_capacity)
       capacity = new_capacity;
    }
 
-   // Creating temp dynamic array with new capacity value.
-   int * temp_array = new int[capacity];
+   // Growing/shrinking the array in place when possible, otherwise
+   // realloc relocates the elements with one block copy
+   int * temp_array = static_cast<int*>(realloc(data,
+                                                capacity * sizeof(int)));
+   if (temp_array == NULL)
+   {
+      cerr << "IntSet: reallocation to " << capacity
+           << " ints failed" << endl;
+      exit(EXIT_FAILURE);
+   }
+   data = temp_array;
+   ++reallocs;
+}
 
-   // Transferring old elements to new dynamic array.
-   for (int i = 0; i < used; i++)
+void IntSet::grow()
+{
+   if (capacity >= INT_MAX)
    {
-      temp_array[i] = data[i];
+      cerr << "IntSet: reallocation beyond " << capacity
+           << " ints failed" << endl;
+      exit(EXIT_FAILURE);
    }
 
-   // Deallocating old array.
-   delete [] data;
-   // Assigning data to new array.
-   data = temp_array;
-   // Removing temp_array pointer because it is no longer needed
-   temp_array = NULL;
-   delete temp_array;
+   // Computing in double so a large growth factor (or capacity)
+   // can't overflow int
+   double target = growth * capacity + 1.0;
+   int new_capacity = (target >= double(INT_MAX)) ? INT_MAX : int(target);
+   if (new_capacity <= capacity)
+   {
+      new_capacity = capacity + 1;
+   }
+   resize(new_capacity);
 }
 
-IntSet::IntSet(int initial_capacity) : capacity(initial_capacity), used(0)
+int IntSet::lowerBound(int anInt) const
+{
+   // Binary search over the sorted range data[0] .. data[used - 1]
+   int low = 0;
+   int high = used;
+   while (low < high)
+   {
+      int mid = low + (high - low) / 2;
+      if (data[mid] < anInt)
+      {
+         low = mid + 1;
+      }
+      else
+      {
+         high = mid;
+      }
+   }
+   return low;
+}
+
+IntSet::IntSet(int initial_capacity, StorageMode mode)
+   : capacity(initial_capacity), used(0), mode(mode),
+     growth(DEFAULT_GROWTH_FACTOR), reallocs(0)
 {
    // Initializing capacity to DEFAULT_CAPACITY if initial_capacity < 1
    if (initial_capacity < 1)
@@ -118,54 +230,111 @@ IntSet::IntSet(int initial_capacity) : capacity(initial_capacity), used(0)
       capacity = DEFAULT_CAPACITY;
    }
    // Assingning 'data' to a new intance of a dynamic array of size 'capacity'
-   data = new int[capacity];
+   data = allocate(capacity);
 }
 
-IntSet::IntSet(const IntSet& src) : capacity(src.capacity), used(src.used)
+IntSet::IntSet(const int* first, const int* last, StorageMode mode)
+   : capacity(int(last - first)), used(0), mode(mode),
+     growth(DEFAULT_GROWTH_FACTOR), reallocs(0)
 {
+   if (capacity < 1)
+   {
+      capacity = DEFAULT_CAPACITY;
+   }
+   data = allocate(capacity);
+
+   if (first == last)
+   {
+      return;
+   }
+   if (mode == SORTED)
+   {
+      // Sorting the input in place in the dynamic array itself, then
+      // squeezing out the duplicates
+      memcpy(data, first, (last - first) * sizeof(int));
+      sort(data, data + (last - first));
+      used = int(unique(data, data + (last - first)) - data);
+   }
+   else
+   {
+      // A sorted, duplicate-free copy of the input tells (by binary
+      // search) whether a value has already been taken, so the first
+      // occurrences can be kept in input order
+      vector<int> sorted(first, last);
+      sort(sorted.begin(), sorted.end());
+      sorted.erase(unique(sorted.begin(), sorted.end()), sorted.end());
+      vector<bool> taken(sorted.size(), false);
+      for (const int* p = first; p != last; ++p)
+      {
+         size_t i = lower_bound(sorted.begin(), sorted.end(), *p)
+                    - sorted.begin();
+         if (!taken[i])
+         {
+            taken[i] = true;
+            data[used++] = *p;
+         }
+      }
+   }
+}
+
+IntSet::IntSet(const IntSet& src)
+   : capacity(src.capacity), used(src.used), mode(src.mode),
+     growth(src.growth), reallocs(0)
+{
+   // A moved-from src owns no dynamic array (capacity 0), so its copy
+   // starts out with the default capacity
+   if (capacity < 1)
+   {
+      capacity = DEFAULT_CAPACITY;
+   }
    // Assingning 'data' to a new intance of a dynamic array of size 'capacity'
-   data = new int[capacity];
+   data = allocate(capacity);
 
-   // Copying every element in src to data
-   for (int i = 0; i < src.used; i++)
+   // Copying every element in src to data in one block
+   if (src.used > 0)
    {
-      data[i] = src.data[i];
+      memcpy(data, src.data, src.used * sizeof(int));
    }
 }
 
 
+IntSet::IntSet(IntSet&& src) noexcept
+   : data(src.data), capacity(src.capacity), used(src.used),
+     mode(src.mode), growth(src.growth), reallocs(src.reallocs)
+{
+   // Taking over src's dynamic array and leaving src without one
+   src.data = NULL;
+   src.capacity = 0;
+   src.used = 0;
+}
+
 IntSet::~IntSet()
 {
    // Deallocating dynamic variables
-   delete [] data;
+   free(data);
    data = NULL;
 }
 
-IntSet& IntSet::operator=(const IntSet& rhs)
+IntSet& IntSet::operator=(IntSet rhs) noexcept
 {
-   // Allocating space in temp array to hold elements in rhs
-   int * temp_array = new int[rhs.capacity];
-   for (int i = 0; i < rhs.used; i++)
-   {
-      temp_array[i] = rhs.data[i];
-   }
-
-   // Deleting current dynamic array pinted to by data
-   // and assigning data to temp_array
-   delete [] data;
-   data = temp_array;
-
-   // Copying over all properties from rhs to data
-   capacity = rhs.capacity;
-   used = rhs.used;
-
-   // Deletingt temp_array pointer because is no longer needed
-   temp_array = NULL;
-   delete temp_array;
+   // rhs is already a copy of (or was moved from) the right-hand
+   // side; trading contents with it hands the old dynamic array to
+   // rhs's destructor
+   swap(rhs);
 
    return *this;
 }
 
+void IntSet::swap(IntSet& other) noexcept
+{
+   std::swap(data, other.data);
+   std::swap(capacity, other.capacity);
+   std::swap(used, other.used);
+   std::swap(mode, other.mode);
+   std::swap(growth, other.growth);
+   std::swap(reallocs, other.reallocs);
+}
+
 int IntSet::size() const
 {
    // Returning # of distinct int values the invoking IntSet currently contains
@@ -179,20 +348,37 @@ bool IntSet::isEmpty() const
    return (used == 0);
 }
 
+IntSet::StorageMode IntSet::storageMode() const
+{
+   return mode;
+}
+
+double IntSet::growthFactor() const
+{
+   return growth;
+}
+
+int IntSet::reallocations() const
+{
+   return reallocs;
+}
+
+size_t IntSet::memoryUsage() const
+{
+   return sizeof(*this) + capacity * sizeof(int);
+}
+
 bool IntSet::contains(int anInt) const
 {
-   if (used > 0)
+   // Sorted storage allows a binary search instead of a linear scan
+   if (mode == SORTED)
    {
-      for (int i = 0; i < used; i++)
-      {
-         // if (data[i] == anInt) // Differnt version
-         if (*(data + i) == anInt)
-         {
-            return true;
-         }
-      }
+      int i = lowerBound(anInt);
+      return (i < used && data[i] == anInt);
    }
-   return false;
+
+   // Linear scan, vectorized (see IntSetKernels.h)
+   return scanContains(data, used, anInt);
 }
 
 bool IntSet::isSubsetOf(const IntSet& otherIntSet) const
@@ -202,6 +388,27 @@ bool IntSet::isSubsetOf(const IntSet& otherIntSet) const
    {
       return true;
    }
+   // A larger set can't be a subset
+   else if (used > otherIntSet.used)
+   {
+      return false;
+   }
+   // Both sides sorted: one merge walk over both arrays
+   else if (mode == SORTED && otherIntSet.mode == SORTED)
+   {
+      int j = 0;
+      for (int i = 0; i < used; i++)
+      {
+         while (j < otherIntSet.used && otherIntSet.data[j] < data[i])
+         {
+            j++;
+         }
+         if (j == otherIntSet.used || otherIntSet.data[j] != data[i])
+         {
+            return false;
+         }
+      }
+   }
    // Check for all elements of invoking set, if any one element is not
    // contained return false.
    else
@@ -227,11 +434,200 @@ void IntSet::DumpData(ostream& out) const
    }
 }
 
-IntSet IntSet::unionWith(const IntSet& otherIntSet) const
+IntSet IntSet::sortedUnion(const IntSet& otherIntSet) const
+{
+   IntSet unionSet(used + otherIntSet.used, SORTED);
+   unionSet.growth = growth;
+   int i = 0, j = 0, k = 0;
+   while (i < used && j < otherIntSet.used)
+   {
+      if (data[i] < otherIntSet.data[j])
+      {
+         unionSet.data[k++] = data[i++];
+      }
+      else if (otherIntSet.data[j] < data[i])
+      {
+         unionSet.data[k++] = otherIntSet.data[j++];
+      }
+      else
+      {
+         unionSet.data[k++] = data[i++];
+         j++;
+      }
+   }
+   while (i < used)
+   {
+      unionSet.data[k++] = data[i++];
+   }
+   while (j < otherIntSet.used)
+   {
+      unionSet.data[k++] = otherIntSet.data[j++];
+   }
+   unionSet.used = k;
+
+   return unionSet;
+}
+
+IntSet IntSet::sortedIntersect(const IntSet& otherIntSet) const
+{
+   IntSet interSet(used < otherIntSet.used ? used : otherIntSet.used,
+                   SORTED);
+   interSet.growth = growth;
+   interSet.used = mergeIntersect(data, used, otherIntSet.data,
+                                  otherIntSet.used, interSet.data);
+
+   return interSet;
+}
+
+IntSet IntSet::sortedSubtract(const IntSet& otherIntSet) const
+{
+   IntSet subtractSet(used, SORTED);
+   subtractSet.growth = growth;
+   subtractSet.used = mergeSubtract(data, used, otherIntSet.data,
+                                    otherIntSet.used, subtractSet.data);
+
+   return subtractSet;
+}
+
+void IntSet::unionInPlace(const IntSet& otherIntSet)
+{
+   if (otherIntSet.used == 0)
+   {
+      return;
+   }
+   if (mode != SORTED || otherIntSet.mode != SORTED)
+   {
+      // Counting the new elements first so the array grows (once)
+      // only if the union doesn't fit
+      int newCount = 0;
+      for (int i = 0; i < otherIntSet.used; i++)
+      {
+         newCount += !contains(otherIntSet.data[i]);
+      }
+      reserve(used + newCount);
+      for (int i = 0; i < otherIntSet.used; i++)
+      {
+         add(otherIntSet.data[i]);
+      }
+      return;
+   }
+
+   // Counting the union's elements (one merge pass) so the array grows
+   // only if the union itself doesn't fit
+   int total = used + otherIntSet.used;
+   for (int i = 0, j = 0; i < used && j < otherIntSet.used; )
+   {
+      if (data[i] < otherIntSet.data[j])
+      {
+         i++;
+      }
+      else if (otherIntSet.data[j] < data[i])
+      {
+         j++;
+      }
+      else
+      {
+         --total;
+         i++;
+         j++;
+      }
+   }
+   reserve(total);
+
+   // Merging from the back so nothing is overwritten before it has
+   // been read: at each step the k elements still to be written
+   // include the i + 1 of data[0] .. data[i], so k - 1 >= i and the
+   // union ends up exactly in data[0] .. data[total - 1]
+   int i = used - 1, j = otherIntSet.used - 1, k = total;
+   while (i >= 0 && j >= 0)
+   {
+      if (otherIntSet.data[j] < data[i])
+      {
+         data[--k] = data[i--];
+      }
+      else if (data[i] < otherIntSet.data[j])
+      {
+         data[--k] = otherIntSet.data[j--];
+      }
+      else
+      {
+         data[--k] = data[i--];
+         j--;
+      }
+   }
+   while (j >= 0)
+   {
+      data[--k] = otherIntSet.data[j--];
+   }
+   while (i >= 0)
+   {
+      data[--k] = data[i--];
+   }
+   used = total;
+}
+
+void IntSet::intersectInPlace(const IntSet& otherIntSet)
 {
-   // Instanciating IntSet unionSet = *this to hold union elements of both
-   // this and otherIntSet
-   IntSet unionSet = *this;
+   // Only the scalar merge may write its output over its first
+   // input (see IntSetKernels.h)
+   if (mode == SORTED && otherIntSet.mode == SORTED)
+   {
+      used = mergeIntersectScalar(data, used, otherIntSet.data,
+                                  otherIntSet.used, data);
+      return;
+   }
+
+   // Compacting the elements that are kept to the front
+   int k = 0;
+   for (int i = 0; i < used; i++)
+   {
+      if (otherIntSet.contains(data[i]))
+      {
+         data[k++] = data[i];
+      }
+   }
+   used = k;
+}
+
+void IntSet::subtractInPlace(const IntSet& otherIntSet)
+{
+   if (mode == SORTED && otherIntSet.mode == SORTED)
+   {
+      used = mergeSubtract(data, used, otherIntSet.data,
+                           otherIntSet.used, data);
+      return;
+   }
+
+   int k = 0;
+   for (int i = 0; i < used; i++)
+   {
+      if (!otherIntSet.contains(data[i]))
+      {
+         data[k++] = data[i];
+      }
+   }
+   used = k;
+}
+
+IntSet IntSet::unionWith(const IntSet& otherIntSet) const &
+{
+   // Both sides sorted: merging into an array sized for the largest
+   // possible union (used + otherIntSet.used)
+   if (mode == SORTED && otherIntSet.mode == SORTED)
+   {
+      return sortedUnion(otherIntSet);
+   }
+
+   // Instanciating IntSet unionSet as a copy of *this to hold union
+   // elements of both this and otherIntSet, with room for all of them
+   // from the start (so the adds below never grow it)
+   IntSet unionSet(used + otherIntSet.used, mode);
+   unionSet.growth = growth;
+   if (used > 0)
+   {
+      memcpy(unionSet.data, data, used * sizeof(int));
+   }
+   unionSet.used = used;
 
    // Copying over unique elements from ohterIntSet since all
    // elements from *this are already contained
@@ -243,8 +639,15 @@ IntSet IntSet::unionWith(const IntSet& otherIntSet) const
    return unionSet;
 }
 
-IntSet IntSet::intersect(const IntSet& otherIntSet) const
+IntSet IntSet::intersect(const IntSet& otherIntSet) const &
 {
+   // Both sides sorted: keeping only the elements both merge
+   // streams have in common
+   if (mode == SORTED && otherIntSet.mode == SORTED)
+   {
+      return sortedIntersect(otherIntSet);
+   }
+
    // IntSet representing the intersection of the invoking IntSet
    // and otherIntSet that will be returned
    IntSet interSet = *this;
@@ -253,7 +656,7 @@ IntSet IntSet::intersect(const IntSet& otherIntSet) const
    // from the interSet
    for (int i = 0; i < used; i++)
    {
-      if (!otherIntSet.contains(interSet.data[i]))
+      if (!otherIntSet.contains(data[i]))
       {
          interSet.remove(data[i]);
       }
@@ -262,8 +665,15 @@ IntSet IntSet::intersect(const IntSet& otherIntSet) const
    return interSet;
 }
 
-IntSet IntSet::subtract(const IntSet& otherIntSet) const
+IntSet IntSet::subtract(const IntSet& otherIntSet) const &
 {
+   // Both sides sorted: keeping the elements of the invoking IntSet
+   // that the merge doesn't find in otherIntSet
+   if (mode == SORTED && otherIntSet.mode == SORTED)
+   {
+      return sortedSubtract(otherIntSet);
+   }
+
    // IntSet representing the difference between the
    // invoking IntSet and otherIntSet
    IntSet subtractSet = *this;
@@ -280,18 +690,102 @@ IntSet IntSet::subtract(const IntSet& otherIntSet) const
    return subtractSet;
 }
 
+IntSet IntSet::unionWith(const IntSet& otherIntSet) &&
+{
+   // A set united with itself is unchanged
+   if (&otherIntSet != this)
+   {
+      unionInPlace(otherIntSet);
+   }
+   return std::move(*this);
+}
+
+IntSet IntSet::intersect(const IntSet& otherIntSet) &&
+{
+   if (&otherIntSet != this)
+   {
+      intersectInPlace(otherIntSet);
+   }
+   return std::move(*this);
+}
+
+IntSet IntSet::subtract(const IntSet& otherIntSet) &&
+{
+   // A set minus itself is empty
+   if (&otherIntSet == this)
+   {
+      used = 0;
+   }
+   else
+   {
+      subtractInPlace(otherIntSet);
+   }
+   return std::move(*this);
+}
+
 void IntSet::reset()
 {
    // Deleting all array data, creating new empty array
    // and reseting used to 0
-   delete [] data;
-   data = new int[DEFAULT_CAPACITY];
+   free(data);
+   data = allocate(DEFAULT_CAPACITY);
    used = 0;
    capacity = DEFAULT_CAPACITY;
 }
 
+void IntSet::reserve(int min_capacity)
+{
+   // Only ever grows; a smaller request leaves the capacity alone
+   if (min_capacity > capacity)
+   {
+      resize(min_capacity);
+   }
+}
+
+void IntSet::shrinkToFit()
+{
+   // resize() adjusts an empty IntSet's capacity to DEFAULT_CAPACITY
+   int needed = (used > 0) ? used : DEFAULT_CAPACITY;
+   if (capacity != needed)
+   {
+      resize(needed);
+   }
+}
+
+void IntSet::setGrowthFactor(double factor)
+{
+   // Factors that wouldn't grow the array fall back to the default
+   growth = (factor > 1.0) ? factor : DEFAULT_GROWTH_FACTOR;
+}
+
 bool IntSet::add(int anInt)
 {
+   if (mode == SORTED)
+   {
+      // Locating the position anInt belongs at, if already there
+      // then false is returned
+      int pos = lowerBound(anInt);
+      if (pos < used && data[pos] == anInt)
+      {
+         return false;
+      }
+
+      if (used >= capacity)
+      {
+         grow();
+      }
+
+      // Shifting larger elements to the right to make room
+      for (int i = used; i > pos; --i)
+      {
+         data[i] = data[i - 1];
+      }
+      data[pos] = anInt;
+      used++;
+
+      return true;
+   }
+
    // Validating new value, if not new then false is returned
    if (!contains(anInt))
    {
@@ -300,7 +794,7 @@ bool IntSet::add(int anInt)
       if (used >= capacity)
       {
          // Resizing to atleast capacity + 1.
-         resize(int(1.5 * capacity) + 1);
+         grow();
       }
 
       // Adding new element
@@ -315,8 +809,67 @@ bool IntSet::add(int anInt)
    }
 }
 
+int IntSet::addAll(const int* first, const int* last)
+{
+   int oldUsed = used;
+
+   if (mode == SORTED)
+   {
+      // One sort of the input, then one merge (from the back) into
+      // data, which grows at most once
+      IntSet incoming(first, last, SORTED);
+      unionInPlace(incoming);
+   }
+   else
+   {
+      // The input's distinct values in first-occurrence order; those
+      // not already members (found by binary search in a sorted copy
+      // of data) are appended after one reserve for all of them
+      IntSet incoming(first, last, INSERTION_ORDER);
+      vector<int> members(data, data + used);
+      sort(members.begin(), members.end());
+
+      vector<bool> isNew(incoming.used);
+      int newCount = 0;
+      for (int i = 0; i < incoming.used; i++)
+      {
+         isNew[i] = !binary_search(members.begin(), members.end(),
+                                   incoming.data[i]);
+         newCount += isNew[i];
+      }
+      reserve(used + newCount);
+      for (int i = 0; i < incoming.used; i++)
+      {
+         if (isNew[i])
+         {
+            data[used++] = incoming.data[i];
+         }
+      }
+   }
+
+   return used - oldUsed;
+}
+
 bool IntSet::remove(int anInt)
 {
+   if (mode == SORTED)
+   {
+      int pos = lowerBound(anInt);
+      if (pos == used || data[pos] != anInt)
+      {
+         return false;
+      }
+
+      // Sifting all larger elements to the left
+      for (int j = pos; j < used - 1; j++)
+      {
+         data[j] = data[j + 1];
+      }
+      --used;
+
+      return true;
+   }
+
    // Checking to see if anInt is contained in 'data'
    // if contained, we proceed with removal
    if (contains(anInt))
@@ -348,6 +901,11 @@ bool operator==(const IntSet& is1, const IntSet& is2)
    {
       return true;
    }
+   // Sets of different sizes can't have the same elements
+   else if (is1.size() != is2.size())
+   {
+      return false;
+   }
    // if they are both subsets of eachother then they are equal
    else if (is1.isSubsetOf(is2) && is2.isSubsetOf(is1))
    {
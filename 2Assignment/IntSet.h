@@ -10,15 +10,58 @@
 //     values "an IntSet created by the default constructor"
 //     can accommodate).
 //
+//   static const double DEFAULT_GROWTH_FACTOR = ____
+//     IntSet::DEFAULT_GROWTH_FACTOR is the factor by which add grows
+//     the capacity of a full IntSet unless setGrowthFactor has been
+//     used to choose another.
+//
+// TYPEDEF
+//   enum StorageMode { INSERTION_ORDER, SORTED }
+//     IntSet::StorageMode selects how the elements of an IntSet
+//     are kept in its dynamic array:
+//     INSERTION_ORDER - elements are kept in order of membership
+//                       (DumpData lists them in the order they
+//                       were added); contains() is a linear scan.
+//     SORTED          - elements are kept in ascending order
+//                       (DumpData lists them in ascending order);
+//                       contains() is a binary search.
+//     The mode affects only performance and the order used by
+//     DumpData; the collection represented (and thus ==) is the
+//     same either way.
+//
 // CONSTRUCTOR
-//   IntSet(int initial_capacity = DEFAULT_CAPACITY)
+//   IntSet(int initial_capacity = DEFAULT_CAPACITY,
+//          StorageMode mode = INSERTION_ORDER)
 //     Post: The invoking IntSet is initialized to an empty
 //           IntSet (i.e., one containing no relevant elements);
 //           the initial capacity is given by initial_capacity if
 //           initial_capacity is >= 1, otherwise it is given by
-//           IntSet:DEFAULT_CAPACITY.
+//           IntSet:DEFAULT_CAPACITY; the storage mode is given by
+//           mode.
 //     Note: When the IntSet is put to use after construction,
 //           its capacity will be resized as necessary.
+//   IntSet(const int* first, const int* last,
+//          StorageMode mode = INSERTION_ORDER)
+//     Pre:  [first, last) is a valid range of ints (e.g., a raw
+//           buffer, or &v[0] .. &v[0] + v.size() of a vector<int>);
+//           it may contain duplicates and be in any order.
+//     Post: The invoking IntSet is initialized to the set of the
+//           distinct values in [first, last), with storage mode mode;
+//           with INSERTION_ORDER their membership order is the order
+//           of their first occurrences in the range. The capacity is
+//           last - first (or DEFAULT_CAPACITY if the range is empty).
+//     Note: The input is sorted and deduplicated in one pass, so
+//           building an IntSet of n values takes O(n log n) time and a
+//           single allocation of its dynamic array (INSERTION_ORDER
+//           also uses a temporary sorted copy), instead of the n
+//           contains() checks and repeated resizes of n calls to add.
+//   IntSet(IntSet&& src) noexcept
+//     Pre:  (none)
+//     Post: The invoking IntSet has taken over the elements (and
+//           the dynamic array holding them) of src without copying
+//           or allocating; src is left an empty IntSet with no
+//           dynamic array (capacity 0), which may still be used,
+//           assigned to or destroyed as usual.
 //
 // CONSTANT MEMBER FUNCTIONS (ACCESSORS)
 //   int size() const
@@ -28,6 +71,28 @@
 //     Pre:  (none)
 //     Post: True is returned if the invoking IntSet has no relevant
 //           elements, otherwise false is returned.
+//   StorageMode storageMode() const
+//     Pre:  (none)
+//     Post: The storage mode of the invoking IntSet is returned.
+//   double growthFactor() const
+//     Pre:  (none)
+//     Post: The factor by which add grows the capacity of the
+//           invoking IntSet when it is full is returned.
+//   int reallocations() const
+//     Pre:  (none)
+//     Post: The number of times the dynamic array of the invoking
+//           IntSet has been reallocated (grown by add, or resized by
+//           reserve or shrinkToFit) since construction is returned.
+//     Note: Loading n elements after reserve(n) costs exactly one
+//           reallocation (none if the capacity was already enough).
+//     Note: The count belongs with the dynamic array: an IntSet that
+//           is assigned to (or moved from) takes over the count of
+//           the array it ends up with.
+//   std::size_t memoryUsage() const
+//     Pre:  (none)
+//     Post: The number of bytes the invoking IntSet occupies (object
+//           plus its dynamic array, unused capacity included) is
+//           returned.
 //   bool contains(int anInt) const
 //     Pre:  (none)
 //     Post: true is returned if the invoking IntSet has anInt as an
@@ -49,10 +114,25 @@
 //     Pre:  (none)
 //     Post: An IntSet representing the union of the invoking IntSet
 //           and otherIntSet is returned.
+//     Note: The IntSet returned (and those returned by intersect and
+//           subtract) has the same storage mode as the invoking IntSet.
+//     Note: When both IntSets are SORTED, unionWith, intersect and
+//           subtract are each computed in a single linear merge pass
+//           into a result whose dynamic array is allocated once, sized
+//           to the largest possible result.
 //     Note: Equivalently (see postcondition of add), the IntSet
 //           returned is one that initially is an exact copy of the
 //           invoking IntSet but subsequently has all elements of
 //           otherIntSet added.
+//     Note: When the invoking IntSet is a temporary (e.g., the result
+//           of another unionWith, intersect or subtract), unionWith,
+//           intersect and subtract work in its dynamic array instead
+//           of allocating a new one, and the result takes that array
+//           over; intersect and subtract then allocate nothing (the
+//           result can't be larger), and unionWith reallocates only
+//           if the array is too small. So a chained expression such
+//           as a.unionWith(b).intersect(c) allocates a dynamic array
+//           only once, for the final result.
 //   IntSet intersect(const IntSet& otherIntSet) const
 //     Pre:  (none)
 //     Post: An IntSet representing the intersection of the invoking
@@ -81,12 +161,51 @@
 //           added to the invoking IntSet as a new element and
 //           true is returned, otherwise the invoking IntSet is
 //           unchanged and false is returned.
+//   int addAll(const int* first, const int* last)
+//     Pre:  [first, last) is a valid range of ints (may contain
+//           duplicates, and values already in the invoking IntSet).
+//     Post: Every value in [first, last) is an element of the invoking
+//           IntSet, and the number of values that were newly added is
+//           returned. With INSERTION_ORDER the new values become
+//           members in the order of their first occurrences in the
+//           range (same as calling add on each value in turn).
+//     Note: Done in bulk, like the constructor above: the range is
+//           sorted and deduplicated once, then merged into the
+//           dynamic array, which is reallocated at most once.
 //   bool remove(int anInt)
 //     Pre:  (none)
 //     Post: If contains(anInt) returns true, anInt has been
 //           removed from the invoking IntSet and true is
 //           returned, otherwise the invoking IntSet is unchanged
 //           and false is returned.
+//   void reserve(int min_capacity)
+//     Pre:  (none)
+//     Post: The capacity of the invoking IntSet is at least
+//           min_capacity (it is unchanged if already that large),
+//           so adding up to min_capacity - size() new elements
+//           will not reallocate.
+//   void shrinkToFit()
+//     Pre:  (none)
+//     Post: The capacity of the invoking IntSet has been reduced to
+//           size() (or DEFAULT_CAPACITY if the IntSet is empty).
+//   void swap(IntSet& other) noexcept
+//     Pre:  (none)
+//     Post: The contents (elements, dynamic array, storage mode,
+//           growth factor and reallocation count) of the invoking
+//           IntSet and other have been exchanged; nothing is copied
+//           or allocated.
+//   void setGrowthFactor(double factor)
+//     Pre:  factor > 1.0
+//     Post: When add finds the invoking IntSet full, its capacity
+//           grows from c to int(factor * c) + 1.
+//     Note: If Pre is not met, DEFAULT_GROWTH_FACTOR is used.
+//     Note: The grown capacity is capped at INT_MAX ints (and is
+//           always at least c + 1), so a huge factor just grows the
+//           array straight to INT_MAX; adding to a full IntSet whose
+//           capacity is already INT_MAX terminates the program.
+//     Note: Copies and the results of unionWith, intersect and
+//           subtract inherit the growth factor of the IntSet they
+//           are made from.
 //
 // NON-MEMBER FUNCTIONS
 //   bool operator==(const IntSet& is1, const IntSet& is2)
@@ -98,38 +217,73 @@
 //
 // VALUE SEMANTICS
 //   Assignment and the copy constructor may be used with IntSet
-//   objects.
+//   objects. Assignment takes its right-hand side by value (copy-
+//   and-swap), so it copies from an lvalue and moves from an rvalue;
+//   it is self-assignment safe, and the invoking IntSet is unchanged
+//   if the copy fails. Temporaries are moved rather than copied
+//   (see the move constructor).
 
 #ifndef INT_SET_H
 #define INT_SET_H
 
+#include <cstddef>
 #include <iostream>
 
 class IntSet
 {
 public:
+   enum StorageMode { INSERTION_ORDER, SORTED };
    static const int DEFAULT_CAPACITY = 1;
-   IntSet(int initial_capacity = DEFAULT_CAPACITY);
+   static constexpr double DEFAULT_GROWTH_FACTOR = 1.5;
+   IntSet(int initial_capacity = DEFAULT_CAPACITY,
+          StorageMode mode = INSERTION_ORDER);
+   IntSet(const int* first, const int* last,
+          StorageMode mode = INSERTION_ORDER);
    IntSet(const IntSet& src);
+   IntSet(IntSet&& src) noexcept;
    ~IntSet();
-   IntSet& operator=(const IntSet& rhs);
+   IntSet& operator=(IntSet rhs) noexcept;
    int size() const;
    bool isEmpty() const;
+   StorageMode storageMode() const;
+   double growthFactor() const;
+   int reallocations() const;
+   std::size_t memoryUsage() const;
    bool contains(int anInt) const;
    bool isSubsetOf(const IntSet& otherIntSet) const;
    void DumpData(std::ostream& out) const;
-   IntSet unionWith(const IntSet& otherIntSet) const;
-   IntSet intersect(const IntSet& otherIntSet) const;
-   IntSet subtract(const IntSet& otherIntSet) const;
+   IntSet unionWith(const IntSet& otherIntSet) const &;
+   IntSet unionWith(const IntSet& otherIntSet) &&;
+   IntSet intersect(const IntSet& otherIntSet) const &;
+   IntSet intersect(const IntSet& otherIntSet) &&;
+   IntSet subtract(const IntSet& otherIntSet) const &;
+   IntSet subtract(const IntSet& otherIntSet) &&;
    void reset();
    bool add(int anInt);
+   int addAll(const int* first, const int* last);
    bool remove(int anInt);
+   void reserve(int min_capacity);
+   void shrinkToFit();
+   void swap(IntSet& other) noexcept;
+   void setGrowthFactor(double factor);
 
 private:
    int* data;
    int  capacity;
    int  used;
+   StorageMode mode;
+   double growth;
+   int  reallocs;
+   static int* allocate(int new_capacity);
    void resize(int new_capacity);
+   void grow();
+   int lowerBound(int anInt) const;
+   IntSet sortedUnion(const IntSet& otherIntSet) const;
+   IntSet sortedIntersect(const IntSet& otherIntSet) const;
+   IntSet sortedSubtract(const IntSet& otherIntSet) const;
+   void unionInPlace(const IntSet& otherIntSet);
+   void intersectInPlace(const IntSet& otherIntSet);
+   void subtractInPlace(const IntSet& otherIntSet);
 };
 
 bool operator==(const IntSet& is1, const IntSet& is2);
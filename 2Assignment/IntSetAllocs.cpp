@@ -0,0 +1,122 @@
+// FILE: IntSetAllocs.cpp
+//       An allocation-counting check for chained IntSet set operations.
+//       Each chain below is evaluated in both storage modes
+//       (INSERTION_ORDER and SORTED) with malloc and realloc counted
+//       (calloc and operator new reach malloc too). A chain's
+//       temporaries hand their dynamic arrays along (see the note on
+//       unionWith in IntSet.h), so it should allocate exactly once,
+//       for the final result:
+//          a.unionWith(b).intersect(c)
+//          a.subtract(c).unionWith(a)
+//          a.intersect(b).subtract(c)
+//       The count for each chain and mode is written to cout, and the
+//       program exits with EXIT_FAILURE if any chain allocated more
+//       than once (or got the wrong result).
+//       NOTE: glibc only: malloc and realloc are replaced by versions
+//             that count the calls made while counting is on and pass
+//             every call on to __libc_malloc and __libc_realloc.
+
+#include "IntSet.h"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+
+// Allocations seen while counting is true
+static bool counting = false;
+static long allocations = 0;
+
+extern "C" void* malloc(size_t size)
+{
+   if (counting)
+   {
+      ++allocations;
+   }
+   return __libc_malloc(size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size)
+{
+   if (counting)
+   {
+      ++allocations;
+   }
+   return __libc_realloc(ptr, size);
+}
+
+// Makes an IntSet of the given mode holding the values from first
+// through last - 1 in steps of step (in descending order, so that
+// INSERTION_ORDER sets are not sorted)
+IntSet makeSet(int first, int last, int step, IntSet::StorageMode mode)
+{
+   vector<int> values;
+   for (int v = last - 1; v >= first; --v)
+   {
+      if ((v - first) % step == 0)
+      {
+         values.push_back(v);
+      }
+   }
+   return IntSet(values.data(), values.data() + values.size(), mode);
+}
+
+// Writes a row for one chain and returns true if it allocated once
+// and its result has size expected
+bool report(const char chain[], const char mode[], long count,
+            const IntSet& result, int expected)
+{
+   bool good = (count == 1 && result.size() == expected);
+   cout << setw(30) << chain << setw(18) << mode << setw(8) << count
+        << (good ? "" : "   FAIL") << endl;
+   return good;
+}
+
+int main()
+{
+   const IntSet::StorageMode MODES[] = { IntSet::INSERTION_ORDER,
+                                         IntSet::SORTED };
+   const char* MODE_NAMES[] = { "INSERTION_ORDER", "SORTED" };
+   bool allGood = true;
+
+   cout << setw(30) << "chain" << setw(18) << "mode" << setw(8)
+        << "allocs" << endl;
+   for (int m = 0; m < 2; ++m)
+   {
+      // a = 0 .. 1999, b = evens of 1000 .. 2999, c = multiples of 3
+      // of 0 .. 2999
+      IntSet a = makeSet(0, 2000, 1, MODES[m]);
+      IntSet b = makeSet(1000, 3000, 2, MODES[m]);
+      IntSet c = makeSet(0, 3000, 3, MODES[m]);
+
+      allocations = 0;
+      counting = true;
+      IntSet r1 = a.unionWith(b).intersect(c);
+      counting = false;
+      // (a union b) = 0 .. 1999 and evens of 2000 .. 2999: 2500 values,
+      // of which 667 + 166 are multiples of 3
+      allGood &= report("a.unionWith(b).intersect(c)", MODE_NAMES[m],
+                        allocations, r1, 833);
+
+      allocations = 0;
+      counting = true;
+      IntSet r2 = a.subtract(c).unionWith(a);
+      counting = false;
+      allGood &= report("a.subtract(c).unionWith(a)", MODE_NAMES[m],
+                        allocations, r2, 2000);
+
+      allocations = 0;
+      counting = true;
+      IntSet r3 = a.intersect(b).subtract(c);
+      counting = false;
+      // a intersect b = evens of 1000 .. 1999 (500), less the 167
+      // multiples of 6
+      allGood &= report("a.intersect(b).subtract(c)", MODE_NAMES[m],
+                        allocations, r3, 333);
+   }
+
+   return allGood ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,347 @@
+// FILE: IntSetBench.cpp
+//       A micro-benchmark program for the IntSet array kernels and
+//       the IntSet backends.
+//       (1) For sets of 1K, 64K and 1M elements, the scalar and the
+//           dispatched (SIMD) versions of each kernel are timed on the
+//           same data and their results are checked to agree.
+//       (2) A SORTED IntSet and a BitmapIntSet are loaded with the
+//           same dense and sparse data (64K and 1M elements), then
+//           compared on memory per element (as reported by their
+//           memoryUsage) and time per operation.
+//       (3) Loading an IntSet with 64K and 1M random values (with
+//           duplicates) one add() at a time is compared with loading
+//           it in bulk with the range constructor.
+
+#include "BitmapIntSet.h"
+#include "IntSet.h"
+#include "IntSetKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+// PROTOTYPES for functions used by this benchmark program:
+
+vector<int> random_sorted_values(int n);
+// Pre:  n >= 0
+// Post: A vector of n distinct random values in ascending order is
+//       returned; consecutive values differ by 1 to 7 (4 on average),
+//       so two such vectors share about a quarter of their values.
+
+double elapsed_ns(chrono::steady_clock::time_point since);
+// Pre:  (none)
+// Post: Nanoseconds elapsed since the given time point is returned.
+
+void print_row(const char kernel[], int n, double scalar_ns,
+               double simd_ns);
+// Pre:  (none)
+// Post: One row of the results table has been written to cout.
+
+void bench_contains(int n);
+void bench_intersect(int n);
+void bench_subtract(int n);
+// Pre:  n >= 1
+// Post: The named kernel has been timed (scalar and dispatched) on
+//       inputs of n elements and the results written to cout.
+
+template <class SetType>
+void bench_backend(const char name[], SetType& s1, SetType& s2,
+                   const vector<int>& values1, const vector<int>& values2,
+                   const vector<int>& probes);
+// Pre:  s1 and s2 are empty; values1 and values2 are ascending.
+// Post: s1 and s2 have been loaded with values1 and values2 and the
+//       memory per element and the time per add, contains (one per
+//       probe), unionWith, intersect and subtract written to cout.
+
+void bench_backends(int n, bool dense);
+// Pre:  n >= 1
+// Post: IntSet (SORTED) and BitmapIntSet have been compared by
+//       bench_backend on n dense values (0 .. n-1, and n/2 .. 3n/2-1
+//       for the second set) or n sparse values (random 31-bit ints).
+
+void bench_bulk_load(int n);
+// Pre:  n >= 1
+// Post: The time to load n random values (about 1 in 8 a duplicate)
+//       into an IntSet by add() calls and by the range constructor,
+//       in each storage mode, has been written to cout. (The add()
+//       loop of an INSERTION_ORDER IntSet is quadratic, so it is only
+//       timed for n <= 64K.)
+
+volatile long sink;   // keeps results alive so timed work isn't elided
+
+int main()
+{
+   const int SIZES[] = { 1 << 10, 1 << 16, 1 << 20 };
+   const int NUM_SIZES = sizeof(SIZES) / sizeof(SIZES[0]);
+
+   cout << "dispatched kernels use: " << kernelIsa() << endl;
+   cout << left << setw(12) << "kernel" << right << setw(10) << "n"
+        << setw(14) << "scalar ns" << setw(14) << "simd ns"
+        << setw(10) << "speedup" << endl;
+
+   for (int i = 0; i < NUM_SIZES; ++i)
+   {
+      bench_contains(SIZES[i]);
+      bench_intersect(SIZES[i]);
+      bench_subtract(SIZES[i]);
+   }
+
+   cout << endl << left << setw(26) << "backend" << right
+        << setw(10) << "B/elem" << setw(10) << "add ns"
+        << setw(12) << "contains ns" << setw(12) << "union ms"
+        << setw(12) << "inter ms" << setw(12) << "subtr ms" << endl;
+   for (int i = 1; i < NUM_SIZES; ++i)
+   {
+      bench_backends(SIZES[i], true);
+      bench_backends(SIZES[i], false);
+   }
+
+   cout << endl << left << setw(26) << "load" << right
+        << setw(10) << "n" << setw(14) << "add() ms"
+        << setw(14) << "bulk ms" << setw(10) << "speedup" << endl;
+   for (int i = 1; i < NUM_SIZES; ++i)
+   {
+      bench_bulk_load(SIZES[i]);
+   }
+
+   return EXIT_SUCCESS;
+}
+
+vector<int> random_sorted_values(int n)
+{
+   vector<int> values(n);
+   int value = 0;
+   for (int i = 0; i < n; ++i)
+   {
+      value += 1 + rand() % 7;
+      values[i] = value;
+   }
+   return values;
+}
+
+double elapsed_ns(chrono::steady_clock::time_point since)
+{
+   return chrono::duration<double, nano>(chrono::steady_clock::now()
+                                         - since).count();
+}
+
+void print_row(const char kernel[], int n, double scalar_ns,
+               double simd_ns)
+{
+   cout << left << setw(12) << kernel << right << setw(10) << n
+        << fixed << setprecision(1)
+        << setw(14) << scalar_ns << setw(14) << simd_ns
+        << setprecision(2) << setw(9) << scalar_ns / simd_ns << "x"
+        << endl;
+}
+
+void bench_contains(int n)
+{
+   // Unsorted (membership-order) data, as in an INSERTION_ORDER IntSet;
+   // most lookups miss and scan the whole array
+   vector<int> data = random_sorted_values(n);
+   random_shuffle(data.begin(), data.end());
+   const int LOOKUPS = max(16, (1 << 26) / n);
+   vector<int> keys(LOOKUPS);
+   for (int i = 0; i < LOOKUPS; ++i)
+      keys[i] = rand() % (4 * n);
+
+   long found = 0;
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int i = 0; i < LOOKUPS; ++i)
+      found += scanContainsScalar(&data[0], n, keys[i]);
+   double scalar_ns = elapsed_ns(start) / LOOKUPS;
+
+   long simd_found = 0;
+   start = chrono::steady_clock::now();
+   for (int i = 0; i < LOOKUPS; ++i)
+      simd_found += scanContains(&data[0], n, keys[i]);
+   double simd_ns = elapsed_ns(start) / LOOKUPS;
+
+   if (found != simd_found)
+      cerr << "contains: kernel results differ at n = " << n << endl;
+   sink = found;
+   print_row("contains", n, scalar_ns, simd_ns);
+}
+
+void bench_intersect(int n)
+{
+   vector<int> a = random_sorted_values(n);
+   vector<int> b = random_sorted_values(n);
+   vector<int> out(n);
+   const int REPS = max(4, (1 << 24) / n);
+
+   long total = 0;
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int r = 0; r < REPS; ++r)
+      total += mergeIntersectScalar(&a[0], n, &b[0], n, &out[0]);
+   double scalar_ns = elapsed_ns(start) / REPS;
+
+   long simd_total = 0;
+   start = chrono::steady_clock::now();
+   for (int r = 0; r < REPS; ++r)
+      simd_total += mergeIntersect(&a[0], n, &b[0], n, &out[0]);
+   double simd_ns = elapsed_ns(start) / REPS;
+
+   if (total != simd_total)
+      cerr << "intersect: kernel results differ at n = " << n << endl;
+   sink = total;
+   print_row("intersect", n, scalar_ns, simd_ns);
+}
+
+void bench_subtract(int n)
+{
+   vector<int> a = random_sorted_values(n);
+   vector<int> b = random_sorted_values(n);
+   vector<int> out(n);
+   const int REPS = max(4, (1 << 24) / n);
+
+   long total = 0;
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (int r = 0; r < REPS; ++r)
+      total += mergeSubtractScalar(&a[0], n, &b[0], n, &out[0]);
+   double scalar_ns = elapsed_ns(start) / REPS;
+
+   long simd_total = 0;
+   start = chrono::steady_clock::now();
+   for (int r = 0; r < REPS; ++r)
+      simd_total += mergeSubtract(&a[0], n, &b[0], n, &out[0]);
+   double simd_ns = elapsed_ns(start) / REPS;
+
+   if (total != simd_total)
+      cerr << "subtract: kernel results differ at n = " << n << endl;
+   sink = total;
+   print_row("subtract", n, scalar_ns, simd_ns);
+}
+
+template <class SetType>
+void bench_backend(const char name[], SetType& s1, SetType& s2,
+                   const vector<int>& values1, const vector<int>& values2,
+                   const vector<int>& probes)
+{
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (size_t i = 0; i < values1.size(); ++i)
+      s1.add(values1[i]);
+   double add_ns = elapsed_ns(start) / values1.size();
+   double bytes_per_elem = double(s1.memoryUsage()) / s1.size();
+   for (size_t i = 0; i < values2.size(); ++i)
+      s2.add(values2[i]);
+
+   long found = 0;
+   start = chrono::steady_clock::now();
+   for (size_t i = 0; i < probes.size(); ++i)
+      found += s1.contains(probes[i]);
+   double contains_ns = elapsed_ns(start) / probes.size();
+
+   start = chrono::steady_clock::now();
+   found += s1.unionWith(s2).size();
+   double union_ms = elapsed_ns(start) / 1e6;
+   start = chrono::steady_clock::now();
+   found += s1.intersect(s2).size();
+   double intersect_ms = elapsed_ns(start) / 1e6;
+   start = chrono::steady_clock::now();
+   found += s1.subtract(s2).size();
+   double subtract_ms = elapsed_ns(start) / 1e6;
+   sink = found;
+
+   cout << left << setw(26) << name << right << fixed << setprecision(2)
+        << setw(10) << bytes_per_elem << setw(10) << add_ns
+        << setw(12) << contains_ns << setw(12) << union_ms
+        << setw(12) << intersect_ms << setw(12) << subtract_ms << endl;
+}
+
+void bench_backends(int n, bool dense)
+{
+   vector<int> values1(n), values2(n), probes(1 << 20);
+   if (dense)
+   {
+      for (int i = 0; i < n; ++i)
+      {
+         values1[i] = i;
+         values2[i] = n / 2 + i;
+      }
+      for (size_t i = 0; i < probes.size(); ++i)
+         probes[i] = rand() % (2 * n);
+   }
+   else
+   {
+      for (int i = 0; i < n; ++i)
+      {
+         values1[i] = rand();
+         values2[i] = (i % 2) ? values1[i] : rand();
+      }
+      sort(values1.begin(), values1.end());
+      values1.erase(unique(values1.begin(), values1.end()), values1.end());
+      sort(values2.begin(), values2.end());
+      values2.erase(unique(values2.begin(), values2.end()), values2.end());
+      for (size_t i = 0; i < probes.size(); ++i)
+         probes[i] = (i % 2) ? values1[rand() % values1.size()] : rand();
+   }
+
+   cout << (dense ? "dense " : "sparse ") << n << ":" << endl;
+   {
+      IntSet s1(1, IntSet::SORTED), s2(1, IntSet::SORTED);
+      bench_backend("  IntSet (SORTED)", s1, s2, values1, values2, probes);
+   }
+   {
+      BitmapIntSet s1, s2;
+      bench_backend("  BitmapIntSet", s1, s2, values1, values2, probes);
+   }
+   {
+      // Memory once the loaded BitmapIntSet is run-length encoded
+      BitmapIntSet s1;
+      for (size_t i = 0; i < values1.size(); ++i)
+         s1.add(values1[i]);
+      s1.runOptimize();
+      cout << left << setw(26) << "  BitmapIntSet (runs)" << right
+           << fixed << setprecision(4) << setw(10)
+           << double(s1.memoryUsage()) / s1.size() << endl;
+   }
+}
+
+void bench_bulk_load(int n)
+{
+   vector<int> values(n);
+   for (int i = 0; i < n; ++i)
+      values[i] = rand() % (8 * n / 7);
+   const int* first = &values[0];
+   const int* last = first + n;
+
+   const IntSet::StorageMode MODES[] = { IntSet::INSERTION_ORDER,
+                                         IntSet::SORTED };
+   const char* NAMES[] = { "  IntSet (INSERTION_ORDER)",
+                           "  IntSet (SORTED)" };
+   for (int m = 0; m < 2; ++m)
+   {
+      double add_ms = 0;
+      long loaded = 0;
+      if (MODES[m] == IntSet::SORTED || n <= (1 << 16))
+      {
+         chrono::steady_clock::time_point start = chrono::steady_clock::now();
+         IntSet s(1, MODES[m]);
+         for (int i = 0; i < n; ++i)
+            s.add(values[i]);
+         add_ms = elapsed_ns(start) / 1e6;
+         loaded = s.size();
+      }
+
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      IntSet bulk(first, last, MODES[m]);
+      double bulk_ms = elapsed_ns(start) / 1e6;
+      if (loaded != 0 && loaded != bulk.size())
+         cerr << "bulk load: sizes differ at n = " << n << endl;
+      sink = bulk.size();
+
+      cout << left << setw(26) << NAMES[m] << right << setw(10) << n
+           << fixed << setprecision(2);
+      if (loaded != 0)
+         cout << setw(14) << add_ms << setw(14) << bulk_ms
+              << setprecision(1) << setw(9) << add_ms / bulk_ms << "x";
+      else
+         cout << setw(14) << "-" << setw(14) << bulk_ms;
+      cout << endl;
+   }
+}
@@ -0,0 +1,301 @@
+// FILE: IntSetKernels.cpp - implementation file for the IntSet
+//       array kernels (See IntSetKernels.h for documentation.)
+// NOTES on the SIMD versions:
+// (1) They are only compiled for x86 with GCC-compatible compilers.
+//     SSE2 is part of the x86-64 baseline so it needs no run-time
+//     check; the AVX2 version is compiled with a per-function target
+//     attribute and only used if __builtin_cpu_supports says so.
+//     Everywhere else the dispatched kernels are the scalar ones.
+// (2) The sorted merge kernels compare a block of 4 ints of a
+//     against a block of 4 ints of b all-pairs (b rotated 3 times),
+//     which is valid because neither array has duplicates. The block
+//     with the smaller maximum is then retired (both if equal);
+//     whatever is left over (fewer than 4 in either array) is
+//     finished with the scalar merge.
+// (3) The subtract kernels (and the scalar intersect) store out[k]
+//     only after reading a[k] and never read a block of a again once
+//     they have stored over it, which is what lets out be a itself.
+//     The SSE2 intersect stores a block's matches before the block
+//     is retired (and may re-read it), so it can't work in place.
+
+#include "IntSetKernels.h"
+
+#if defined(__GNUC__) && defined(__SSE2__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define INT_SET_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+bool scanContainsScalar(const int* data, int n, int value)
+{
+   for (int i = 0; i < n; i++)
+   {
+      if (data[i] == value)
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
+int mergeIntersectScalar(const int* a, int na, const int* b, int nb,
+                         int* out)
+{
+   int i = 0, j = 0, k = 0;
+   while (i < na && j < nb)
+   {
+      if (a[i] < b[j])
+      {
+         i++;
+      }
+      else if (b[j] < a[i])
+      {
+         j++;
+      }
+      else
+      {
+         out[k++] = a[i++];
+         j++;
+      }
+   }
+   return k;
+}
+
+int mergeSubtractScalar(const int* a, int na, const int* b, int nb,
+                        int* out)
+{
+   int i = 0, j = 0, k = 0;
+   while (i < na && j < nb)
+   {
+      if (a[i] < b[j])
+      {
+         out[k++] = a[i++];
+      }
+      else if (b[j] < a[i])
+      {
+         j++;
+      }
+      else
+      {
+         i++;
+         j++;
+      }
+   }
+   while (i < na)
+   {
+      out[k++] = a[i++];
+   }
+   return k;
+}
+
+#ifdef INT_SET_KERNELS_X86
+
+static bool scanContainsSse2(const int* data, int n, int value)
+{
+   const __m128i key = _mm_set1_epi32(value);
+   int i = 0;
+
+   // 16 ints per iteration, one branch per 16 comparisons
+   for (; i + 16 <= n; i += 16)
+   {
+      const __m128i* p = reinterpret_cast<const __m128i*>(data + i);
+      __m128i eq = _mm_or_si128(
+         _mm_or_si128(_mm_cmpeq_epi32(_mm_loadu_si128(p), key),
+                      _mm_cmpeq_epi32(_mm_loadu_si128(p + 1), key)),
+         _mm_or_si128(_mm_cmpeq_epi32(_mm_loadu_si128(p + 2), key),
+                      _mm_cmpeq_epi32(_mm_loadu_si128(p + 3), key)));
+      if (_mm_movemask_epi8(eq) != 0)
+      {
+         return true;
+      }
+   }
+   return scanContainsScalar(data + i, n - i, value);
+}
+
+__attribute__((target("avx2")))
+static bool scanContainsAvx2(const int* data, int n, int value)
+{
+   const __m256i key = _mm256_set1_epi32(value);
+   int i = 0;
+
+   // 16 ints per iteration, as two 8-wide compares
+   for (; i + 16 <= n; i += 16)
+   {
+      const __m256i* p = reinterpret_cast<const __m256i*>(data + i);
+      __m256i eq = _mm256_or_si256(
+         _mm256_cmpeq_epi32(_mm256_loadu_si256(p), key),
+         _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 1), key));
+      if (_mm256_movemask_epi8(eq) != 0)
+      {
+         return true;
+      }
+   }
+   return scanContainsScalar(data + i, n - i, value);
+}
+
+// Bit i of the result is set if lane i of va equals any lane of vb
+static inline int blockMatchMask(__m128i va, __m128i vb)
+{
+   __m128i m = _mm_cmpeq_epi32(va, vb);
+   m = _mm_or_si128(m, _mm_cmpeq_epi32(va,
+          _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+   m = _mm_or_si128(m, _mm_cmpeq_epi32(va,
+          _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+   m = _mm_or_si128(m, _mm_cmpeq_epi32(va,
+          _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+   return _mm_movemask_ps(_mm_castsi128_ps(m));
+}
+
+static int mergeIntersectSse2(const int* a, int na, const int* b, int nb,
+                              int* out)
+{
+   int i = 0, j = 0, k = 0;
+   const int na4 = na - na % 4;
+   const int nb4 = nb - nb % 4;
+   const int room = (na < nb) ? na : nb;   // guaranteed size of out
+
+   while (i < na4 && j < nb4)
+   {
+      int mask = blockMatchMask(
+         _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+         _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j)));
+      if (k + 4 <= room)
+      {
+         // Branch-free: every lane is stored, only matches are kept
+         for (int lane = 0; lane < 4; lane++)
+         {
+            out[k] = a[i + lane];
+            k += (mask >> lane) & 1;
+         }
+      }
+      else
+      {
+         for (int lane = 0; lane < 4; lane++)
+         {
+            if (mask & (1 << lane))
+            {
+               out[k++] = a[i + lane];
+            }
+         }
+      }
+
+      const int aMax = a[i + 3];
+      const int bMax = b[j + 3];
+      i += (aMax <= bMax) ? 4 : 0;
+      j += (bMax <= aMax) ? 4 : 0;
+   }
+
+   // Values already matched can't match again (no duplicates), so
+   // the scalar merge can simply pick up from i and j
+   return k + mergeIntersectScalar(a + i, na - i, b + j, nb - j, out + k);
+}
+
+static int mergeSubtractSse2(const int* a, int na, const int* b, int nb,
+                             int* out)
+{
+   int i = 0, j = 0, k = 0;
+   int matched = 0;   // lanes of the current a block seen in b so far
+   const int na4 = na - na % 4;
+   const int nb4 = nb - nb % 4;
+
+   while (i < na4 && j < nb4)
+   {
+      matched |= blockMatchMask(
+         _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+         _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j)));
+
+      const int aMax = a[i + 3];
+      const int bMax = b[j + 3];
+      if (aMax <= bMax)
+      {
+         // Every b value <= aMax has been seen, so the unmatched
+         // lanes of this a block are final (out always has room for
+         // the 4 branch-free stores since k <= i here)
+         for (int lane = 0; lane < 4; lane++)
+         {
+            out[k] = a[i + lane];
+            k += ((matched >> lane) & 1) ^ 1;
+         }
+         i += 4;
+         matched = 0;
+      }
+      j += (bMax <= aMax) ? 4 : 0;
+   }
+
+   // Finishing with a scalar merge that skips the lanes of the
+   // partially processed a block that were already matched
+   const int blockStart = i;
+   while (i < na)
+   {
+      if (i - blockStart < 4 && (matched & (1 << (i - blockStart))))
+      {
+         i++;
+         continue;
+      }
+      while (j < nb && b[j] < a[i])
+      {
+         j++;
+      }
+      if (j < nb && b[j] == a[i])
+      {
+         i++;
+         j++;
+      }
+      else
+      {
+         out[k++] = a[i++];
+      }
+   }
+   return k;
+}
+
+#endif // INT_SET_KERNELS_X86
+
+typedef bool (*ContainsKernel)(const int*, int, int);
+
+static ContainsKernel pickContainsKernel()
+{
+#ifdef INT_SET_KERNELS_X86
+   if (__builtin_cpu_supports("avx2"))
+   {
+      return scanContainsAvx2;
+   }
+   return scanContainsSse2;
+#else
+   return scanContainsScalar;
+#endif
+}
+
+bool scanContains(const int* data, int n, int value)
+{
+   // Resolved once, on first use
+   static const ContainsKernel kernel = pickContainsKernel();
+   return kernel(data, n, value);
+}
+
+int mergeIntersect(const int* a, int na, const int* b, int nb, int* out)
+{
+#ifdef INT_SET_KERNELS_X86
+   return mergeIntersectSse2(a, na, b, nb, out);
+#else
+   return mergeIntersectScalar(a, na, b, nb, out);
+#endif
+}
+
+int mergeSubtract(const int* a, int na, const int* b, int nb, int* out)
+{
+#ifdef INT_SET_KERNELS_X86
+   return mergeSubtractSse2(a, na, b, nb, out);
+#else
+   return mergeSubtractScalar(a, na, b, nb, out);
+#endif
+}
+
+const char* kernelIsa()
+{
+#ifdef INT_SET_KERNELS_X86
+   return __builtin_cpu_supports("avx2") ? "avx2" : "sse2";
+#else
+   return "scalar";
+#endif
+}
@@ -0,0 +1,57 @@
+// FILE: IntSetKernels.h - header file for the IntSet array kernels
+// FUNCTIONS PROVIDED: low-level scan and merge kernels over int
+//                     arrays, used by IntSet (see IntSet.cpp)
+//
+// Each kernel comes in two versions: a dispatched version that
+// uses the widest SIMD instructions the running CPU supports
+// (AVX2 or SSE2 on x86, chosen once at run time), and a scalar
+// version that is the portable reference (and the fallback on
+// CPUs/compilers without SIMD support). Both versions always
+// produce the same results.
+//
+//   bool scanContains(const int* data, int n, int value)
+//   bool scanContainsScalar(const int* data, int n, int value)
+//     Pre:  data points to an array of at least n ints (n >= 0).
+//     Post: true is returned if value is one of data[0] through
+//           data[n - 1], otherwise false is returned.
+//
+//   int mergeIntersect(const int* a, int na, const int* b, int nb,
+//                      int* out)
+//   int mergeIntersectScalar(const int* a, int na,
+//                            const int* b, int nb, int* out)
+//     Pre:  a[0..na-1] and b[0..nb-1] are each in strictly ascending
+//           order; out has room for at least min(na, nb) ints.
+//           For mergeIntersectScalar only, out may be a itself (to
+//           filter a in place).
+//     Post: The values common to a and b have been written to out in
+//           ascending order and their count is returned.
+//
+//   int mergeSubtract(const int* a, int na, const int* b, int nb,
+//                     int* out)
+//   int mergeSubtractScalar(const int* a, int na,
+//                           const int* b, int nb, int* out)
+//     Pre:  a[0..na-1] and b[0..nb-1] are each in strictly ascending
+//           order; out has room for at least na ints.
+//           out may be a itself (to filter a in place).
+//     Post: The values of a that are not in b have been written to
+//           out in ascending order and their count is returned.
+//
+//   const char* kernelIsa()
+//     Pre:  (none)
+//     Post: The name of the instruction set the dispatched kernels
+//           use on this CPU is returned ("avx2", "sse2" or "scalar").
+
+#ifndef INT_SET_KERNELS_H
+#define INT_SET_KERNELS_H
+
+bool scanContains(const int* data, int n, int value);
+bool scanContainsScalar(const int* data, int n, int value);
+int mergeIntersect(const int* a, int na, const int* b, int nb, int* out);
+int mergeIntersectScalar(const int* a, int na, const int* b, int nb,
+                         int* out);
+int mergeSubtract(const int* a, int na, const int* b, int nb, int* out);
+int mergeSubtractScalar(const int* a, int na, const int* b, int nb,
+                        int* out);
+const char* kernelIsa();
+
+#endif
@@ -0,0 +1,478 @@
+// FILE: IntSetWorkload.cpp
+//       A workload-replay benchmark for the IntSet backends.
+//       A stream of commands in the style of Assign02 (three sets
+//       is1, is2 and is3; a = add, k = remove, c = contains,
+//       b = subset, e = equal, u/i/s = is1 = is1.unionWith(is2) etc.,
+//       r = reset) is generated once (or read from an Assign02 input
+//       file) and then replayed against every backend:
+//          IntSet (INSERTION_ORDER), IntSet (SORTED), BitmapIntSet
+//       For each backend the throughput (ops/sec), the p50 and p99
+//       latency of each kind of command, and the peak resident set
+//       size are written to cout. Each backend is replayed in its own
+//       child process (fork) so that its peak RSS is its own.
+//       NOTE: POSIX only (fork, wait, getrusage); ru_maxrss is taken
+//             to be in KB, as on Linux.
+//
+// USAGE: a2work [option=value ...]
+//   ops=N        # of commands to generate (default 1000000)
+//   keys=N       values are drawn from 0 .. N-1 (default 65536)
+//   dist=D       key distribution: uniform, zipf (skewed, s = 0.99,
+//                hot keys scattered over the range) or seq (ascending,
+//                wrapping around) (default uniform)
+//   mix=LIST     relative weights of the commands, as letter/weight
+//                pairs (default a50,k10,c37,u1,i1,s1)
+//   seed=N       random seed (default 1)
+//   script=FILE  replay the commands of an Assign02 input file (e.g.
+//                a2test.in) instead of generating them; d, m and z
+//                commands are skipped and q ends the script
+//   only=LIST    replay only the listed backends, by letter: o
+//                (INSERTION_ORDER), s (SORTED), b (BitmapIntSet)
+//                (default osb)
+
+#include "BitmapIntSet.h"
+#include "IntSet.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+using namespace std;
+
+// One replayable command: op is the Assign02 command letter; target
+// and other are set numbers 0 .. 2 (other is used by b, e, u, i, s);
+// value is the value for a, k and c.
+struct Command
+{
+   char op;
+   unsigned char target;
+   unsigned char other;
+   int value;
+};
+
+const char OPS[] = "akcbeuisr";   // command letters, in report order
+const int NUM_OPS = sizeof(OPS) - 1;
+const char* OP_NAMES[NUM_OPS] = { "add", "remove", "contains", "subset",
+                                  "equal", "union", "intersect",
+                                  "subtract", "reset" };
+
+struct Config
+{
+   long ops;
+   int keys;
+   string dist;
+   double weights[NUM_OPS];
+   unsigned seed;
+   string script;
+   string only;
+};
+
+// PROTOTYPES for functions used by this benchmark program:
+
+int op_index(char op);
+// Pre:  (none)
+// Post: The position of op in OPS is returned (-1 if op isn't there).
+
+bool parse_args(int argc, char* argv[], Config& config);
+// Pre:  argv[1] .. argv[argc - 1] are option=value strings.
+// Post: config holds the defaults overridden by the options given;
+//       false is returned (after a message to cerr) if an option is
+//       not understood.
+
+vector<Command> generate_commands(const Config& config);
+// Pre:  config.keys >= 1 and at least one weight is > 0.
+// Post: config.ops random commands drawn per config are returned.
+
+bool read_script(const string& file_name, vector<Command>& commands);
+// Pre:  (none)
+// Post: The a, k, c, b, e, u, i, s and r commands of the Assign02
+//       input file file_name (up to q, if any) have been appended to
+//       commands (a hybrid r such as "r 123" becomes one reset per
+//       set); false is returned if the file can't be read.
+
+long peak_rss_kb();
+// Pre:  (none)
+// Post: The peak resident set size of this process so far, in KB,
+//       is returned.
+
+double percentile(vector<float>& samples, double fraction);
+// Pre:  samples is not empty; 0 <= fraction <= 1.
+// Post: The sample at the given fraction of the way through the
+//       sorted samples is returned (samples is partially reordered).
+
+template <class SetType>
+void replay(const char name[], const SetType& empty,
+            const vector<Command>& commands);
+// Pre:  empty is an empty set of the backend to measure.
+// Post: commands have been applied, in order, to three copies of
+//       empty, each one timed; the throughput, per-command p50/p99
+//       latency and peak RSS have been written to cout.
+
+template <class SetType>
+void replay_in_child(const char name[], const SetType& empty,
+                     const vector<Command>& commands);
+// Pre:  Same as replay.
+// Post: replay has been run in a child process, which has exited.
+
+volatile long sink;   // keeps results alive so timed work isn't elided
+
+int main(int argc, char* argv[])
+{
+   Config config;
+   if (!parse_args(argc, argv, config))
+      return EXIT_FAILURE;
+
+   vector<Command> commands;
+   if (config.script.empty())
+   {
+      commands = generate_commands(config);
+      cout << commands.size() << " generated commands, keys 0.."
+           << config.keys - 1 << ", " << config.dist << " keys" << endl;
+   }
+   else
+   {
+      if (!read_script(config.script, commands))
+      {
+         cerr << "a2work: can't read " << config.script << endl;
+         return EXIT_FAILURE;
+      }
+      cout << commands.size() << " commands from " << config.script
+           << endl;
+   }
+
+   if (config.only.find('o') != string::npos)
+      replay_in_child("IntSet (INSERTION_ORDER)",
+                      IntSet(1, IntSet::INSERTION_ORDER), commands);
+   if (config.only.find('s') != string::npos)
+      replay_in_child("IntSet (SORTED)", IntSet(1, IntSet::SORTED),
+                      commands);
+   if (config.only.find('b') != string::npos)
+      replay_in_child("BitmapIntSet", BitmapIntSet(), commands);
+
+   return EXIT_SUCCESS;
+}
+
+int op_index(char op)
+{
+   const char* p = strchr(OPS, op);
+   return (op != '\0' && p != NULL) ? int(p - OPS) : -1;
+}
+
+bool parse_args(int argc, char* argv[], Config& config)
+{
+   config.ops = 1000000;
+   config.keys = 65536;
+   config.dist = "uniform";
+   config.seed = 1;
+   config.only = "osb";
+   string mix = "a50,k10,c37,u1,i1,s1";
+
+   for (int i = 1; i < argc; ++i)
+   {
+      string arg = argv[i];
+      size_t eq = arg.find('=');
+      string key = arg.substr(0, eq);
+      string value = (eq == string::npos) ? "" : arg.substr(eq + 1);
+      if (key == "ops")
+         config.ops = atol(value.c_str());
+      else if (key == "keys")
+         config.keys = atoi(value.c_str());
+      else if (key == "dist")
+         config.dist = value;
+      else if (key == "mix")
+         mix = value;
+      else if (key == "seed")
+         config.seed = unsigned(atol(value.c_str()));
+      else if (key == "script")
+         config.script = value;
+      else if (key == "only")
+         config.only = value;
+      else
+      {
+         cerr << "a2work: unknown option " << arg << endl;
+         return false;
+      }
+   }
+
+   if (config.dist != "uniform" && config.dist != "zipf"
+       && config.dist != "seq")
+   {
+      cerr << "a2work: unknown distribution " << config.dist << endl;
+      return false;
+   }
+   if (config.keys < 1 || config.ops < 0)
+   {
+      cerr << "a2work: keys must be >= 1 and ops >= 0" << endl;
+      return false;
+   }
+
+   // Parsing the mix, e.g. "a40,k20,c34"; letters not given get 0
+   double total = 0;
+   fill(config.weights, config.weights + NUM_OPS, 0.0);
+   size_t start = 0;
+   while (start < mix.size())
+   {
+      size_t end = mix.find(',', start);
+      if (end == string::npos)
+         end = mix.size();
+      int op = op_index(mix[start]);
+      if (op < 0 || end - start < 2)
+      {
+         cerr << "a2work: bad mix entry "
+              << mix.substr(start, end - start) << endl;
+         return false;
+      }
+      config.weights[op] = atof(mix.substr(start + 1,
+                                           end - start - 1).c_str());
+      total += config.weights[op];
+      start = end + 1;
+   }
+   if (total <= 0)
+   {
+      cerr << "a2work: the mix has no command with weight > 0" << endl;
+      return false;
+   }
+   return true;
+}
+
+vector<Command> generate_commands(const Config& config)
+{
+   mt19937 rng(config.seed);
+   discrete_distribution<int> pick_op(config.weights,
+                                      config.weights + NUM_OPS);
+   uniform_int_distribution<int> pick_set(0, 2);
+   uniform_int_distribution<int> pick_key(0, config.keys - 1);
+
+   // Zipf: P(rank r) proportional to 1 / (r + 1)^0.99, sampled by
+   // binary search in the cumulative distribution; ranks are mapped
+   // to keys through a random permutation so hot keys aren't adjacent
+   vector<double> cdf;
+   vector<int> rank_to_key;
+   if (config.dist == "zipf")
+   {
+      cdf.resize(config.keys);
+      double sum = 0;
+      for (int r = 0; r < config.keys; ++r)
+      {
+         sum += 1.0 / pow(r + 1.0, 0.99);
+         cdf[r] = sum;
+      }
+      rank_to_key.resize(config.keys);
+      for (int r = 0; r < config.keys; ++r)
+         rank_to_key[r] = r;
+      shuffle(rank_to_key.begin(), rank_to_key.end(), rng);
+   }
+   uniform_real_distribution<double> unit(0.0, 1.0);
+
+   vector<Command> commands(config.ops);
+   int next_seq = 0;
+   for (long n = 0; n < config.ops; ++n)
+   {
+      Command& command = commands[n];
+      command.op = OPS[pick_op(rng)];
+      command.target = (unsigned char) pick_set(rng);
+      command.other = (unsigned char) pick_set(rng);
+      if (config.dist == "uniform")
+         command.value = pick_key(rng);
+      else if (config.dist == "zipf")
+      {
+         size_t rank = upper_bound(cdf.begin(), cdf.end(),
+                                   unit(rng) * cdf.back()) - cdf.begin();
+         command.value = rank_to_key[min(rank, cdf.size() - 1)];
+      }
+      else
+      {
+         command.value = next_seq;
+         next_seq = (next_seq + 1) % config.keys;
+      }
+   }
+   return commands;
+}
+
+bool read_script(const string& file_name, vector<Command>& commands)
+{
+   ifstream in(file_name.c_str());
+   if (!in)
+      return false;
+
+   string line;
+   while (getline(in, line))
+   {
+      char op = 0;
+      long number = 0;
+      int value = 0;
+      if (!line.empty() && line[line.size() - 1] == '\r')
+         line.erase(line.size() - 1);
+      if (line.empty())
+         continue;
+      op = char(tolower(line[0]));
+      if (op == 'q')
+         break;
+      if (op_index(op) < 0)
+         continue;
+
+      const char* rest = line.c_str() + 1;
+      char* after = NULL;
+      number = strtol(rest, &after, 10);
+      value = int(strtol(after, NULL, 10));
+
+      Command command;
+      command.op = op;
+      command.value = value;
+      command.other = 0;
+      if (op == 'r')
+      {
+         // Hybrid number such as 13 or 123: one reset per digit
+         for (long digits = number; digits > 0; digits /= 10)
+         {
+            if (digits % 10 < 1 || digits % 10 > 3)
+               continue;
+            command.target = (unsigned char) (digits % 10 - 1);
+            commands.push_back(command);
+         }
+         continue;
+      }
+      if (op == 'a' || op == 'k' || op == 'c')
+      {
+         if (number < 1 || number > 3)
+            continue;
+         command.target = (unsigned char) (number - 1);
+      }
+      else
+      {
+         // Paired number such as 12: target 1, other 2
+         if (number / 10 < 1 || number / 10 > 3
+             || number % 10 < 1 || number % 10 > 3)
+            continue;
+         command.target = (unsigned char) (number / 10 - 1);
+         command.other = (unsigned char) (number % 10 - 1);
+      }
+      commands.push_back(command);
+   }
+   return true;
+}
+
+long peak_rss_kb()
+{
+   struct rusage usage;
+   getrusage(RUSAGE_SELF, &usage);
+   return usage.ru_maxrss;
+}
+
+double percentile(vector<float>& samples, double fraction)
+{
+   size_t k = size_t(fraction * (samples.size() - 1));
+   nth_element(samples.begin(), samples.begin() + k, samples.end());
+   return samples[k];
+}
+
+template <class SetType>
+void replay(const char name[], const SetType& empty,
+            const vector<Command>& commands)
+{
+   SetType sets[3] = { empty, empty, empty };
+   vector<float> latency_ns[NUM_OPS];
+   for (int op = 0; op < NUM_OPS; ++op)
+      latency_ns[op].reserve(commands.size() / 4);
+   long baseline_kb = peak_rss_kb();
+   long found = 0;
+
+   chrono::steady_clock::time_point start = chrono::steady_clock::now();
+   for (size_t n = 0; n < commands.size(); ++n)
+   {
+      const Command& command = commands[n];
+      SetType& target = sets[command.target];
+      const SetType& other = sets[command.other];
+
+      chrono::steady_clock::time_point op_start =
+         chrono::steady_clock::now();
+      switch (command.op)
+      {
+      case 'a':
+         found += target.add(command.value);
+         break;
+      case 'k':
+         found += target.remove(command.value);
+         break;
+      case 'c':
+         found += target.contains(command.value);
+         break;
+      case 'b':
+         found += target.isSubsetOf(other);
+         break;
+      case 'e':
+         found += (target == other);
+         break;
+      case 'u':
+         target = target.unionWith(other);
+         break;
+      case 'i':
+         target = target.intersect(other);
+         break;
+      case 's':
+         target = target.subtract(other);
+         break;
+      case 'r':
+         target.reset();
+      }
+      latency_ns[op_index(command.op)].push_back(float(
+         chrono::duration<double, nano>(chrono::steady_clock::now()
+                                        - op_start).count()));
+   }
+   double seconds = chrono::duration<double>(chrono::steady_clock::now()
+                                             - start).count();
+   sink = found + sets[0].size() + sets[1].size() + sets[2].size();
+   long peak_kb = peak_rss_kb();
+
+   cout << endl << name << ": " << fixed << setprecision(0)
+        << commands.size() / seconds << " ops/sec, peak RSS "
+        << setprecision(1) << peak_kb / 1024.0 << " MB (+"
+        << (peak_kb - baseline_kb) / 1024.0 << " MB during replay)"
+        << ", final sizes " << sets[0].size() << " " << sets[1].size()
+        << " " << sets[2].size() << endl;
+   cout << "   " << left << setw(12) << "command" << right
+        << setw(10) << "count" << setw(12) << "p50 ns"
+        << setw(12) << "p99 ns" << endl;
+   for (int op = 0; op < NUM_OPS; ++op)
+   {
+      if (latency_ns[op].empty())
+         continue;
+      size_t count = latency_ns[op].size();
+      double p50 = percentile(latency_ns[op], 0.50);
+      double p99 = percentile(latency_ns[op], 0.99);
+      cout << "   " << left << setw(12) << OP_NAMES[op] << right
+           << setw(10) << count << setprecision(0)
+           << setw(12) << p50 << setw(12) << p99 << endl;
+   }
+}
+
+template <class SetType>
+void replay_in_child(const char name[], const SetType& empty,
+                     const vector<Command>& commands)
+{
+   cout.flush();
+   pid_t pid = fork();
+   if (pid == 0)
+   {
+      replay(name, empty, commands);
+      cout.flush();
+      _exit(EXIT_SUCCESS);
+   }
+   else if (pid < 0)
+   {
+      // No child: measuring in this process (peak RSS then includes
+      // the backends replayed before this one)
+      replay(name, empty, commands);
+      return;
+   }
+   int status;
+   waitpid(pid, &status, 0);
+}
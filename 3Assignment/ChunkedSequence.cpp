@@ -0,0 +1,503 @@
+// FILE: ChunkedSequence.cpp
+// CLASS IMPLEMENTED: chunked_sequence (see ChunkedSequence.h for
+//                    documentation)
+// INVARIANT for the chunked_sequence ADT:
+//   1. The items of the sequence are stored, in order, in the chunks
+//      reached from the member variable root, visiting the tree from
+//      left to right. An empty sequence has no tree (root is NULL);
+//      otherwise no node of the tree is empty, and all chunks are at
+//      the same depth.
+//   2. Every node holds the # of items below it in count, and the # of
+//      items (chunk) or children (inner node) it holds in n:
+//      1 <= n <= CHUNK_CAPACITY (chunk) or FANOUT (inner node). An
+//      inner node's count is the sum of its children's counts.
+//   3. A node's refs is the # of pointers to it: one for each inner
+//      node listing it as a child, and one for each chunked_sequence
+//      whose root it is. A node with refs > 1 is shared and is never
+//      changed; unshare gives the caller a private copy to change
+//      instead. A node is deleted when its refs drops to 0.
+//   4. The index of the current item is in the member variable
+//      current_index. If there is no valid current item, then
+//      current_index is the same number as size() (see the note on
+//      invariant 4 in Sequence.cpp).
+//   5. If cached_chunk is not NULL, it is the chunk holding the items
+//      cached_first through cached_first + cached_chunk->n - 1 of the
+//      sequence. It is set by current and cleared by every change to
+//      the sequence (a change may move, split or delete the chunk).
+//   6. A sequence that has been moved from has no tree (root is NULL)
+//      and current_index 0.
+//
+// DOCUMENTATION for private member (helper) functions:
+//   static void release(node* p)
+//    Pre:  p is NULL or a node of a tree (invariant 3).
+//    Post: One reference to p has been given up; if it was the last,
+//      p has been deleted and its children released in turn.
+//
+//   static node* unshare(node*& p)
+//    Pre:  p is not NULL.
+//    Post: If p was shared, p now points to a new, private copy of it
+//      (sharing the old node's children), and the old node's refs has
+//      been decremented. p is returned.
+//
+//   static node* insert_at(node*& p, size_type position,
+//                          const value_type& entry)
+//    Pre:  p is not NULL; position <= p->count.
+//    Post: entry has been inserted at position of the items below p
+//      (p and the nodes on the path to the changed chunk have been
+//      unshared). If p had to be split, p keeps the first part of the
+//      items and the new node holding the rest is returned (to be
+//      added to p's parent just after p); otherwise NULL is returned.
+//
+//   static void erase_at(node*& p, size_type position)
+//    Pre:  p is not NULL; position < p->count.
+//    Post: The item at position of the items below p has been removed
+//      (p and the nodes on the path to the changed chunk have been
+//      unshared). Children left empty have been released; a child left
+//      less than a quarter full has been merged with a neighbor if the
+//      two fit in one node. p itself may be left empty.
+//
+//   static void merge_children(inner* parent, size_type i)
+//    Pre:  parent is private; i + 1 < parent->n; the items (or
+//      children) of children i and i+1 fit in one node.
+//    Post: Child i + 1 has been merged into child i (which has been
+//      unshared) and released.
+//
+//   const chunk* find_chunk(size_type position, size_type& first) const
+//    Pre:  position < size()
+//    Post: The chunk holding the item at position is returned, and
+//      first is the position of the chunk's first item.
+//
+//   void insert_item(size_type position, const value_type& entry)
+//    Pre:  position <= size()
+//    Post: entry has been inserted at position of the sequence (growing
+//      the tree by one level if the root was split); the cache has been
+//      cleared. current_index is unchanged.
+
+#include <algorithm>
+#include <cassert>
+#include "ChunkedSequence.h"
+using namespace std;
+
+namespace CS3358_FA2019
+{
+   // A node of the tree: the common part of chunks and inner nodes
+   struct chunked_sequence::node
+   {
+      size_type refs;
+      size_type count;
+      size_type n;
+      bool is_chunk;
+   };
+
+   struct chunked_sequence::chunk : node
+   {
+      value_type items[CHUNK_CAPACITY];
+   };
+
+   struct chunked_sequence::inner : node
+   {
+      node* children[FANOUT];
+   };
+
+   // HELPER FUNCTIONS
+   void chunked_sequence::release(node* p)
+   {
+      if (p == NULL || --p->refs > 0)
+      {
+         return;
+      }
+
+      if (p->is_chunk)
+      {
+         delete static_cast<chunk*>(p);
+      }
+      else
+      {
+         inner* q = static_cast<inner*>(p);
+         for (size_type i = 0; i < q->n; ++i)
+         {
+            release(q->children[i]);
+         }
+         delete q;
+      }
+   }
+
+   chunked_sequence::node* chunked_sequence::unshare(node*& p)
+   {
+      if (p->refs == 1)
+      {
+         return p;
+      }
+
+      // Copying the shared node; its children gain the copy as a parent
+      node* copy_of_p;
+      if (p->is_chunk)
+      {
+         copy_of_p = new chunk(*static_cast<chunk*>(p));
+      }
+      else
+      {
+         inner* q = new inner(*static_cast<inner*>(p));
+         for (size_type i = 0; i < q->n; ++i)
+         {
+            ++q->children[i]->refs;
+         }
+         copy_of_p = q;
+      }
+      copy_of_p->refs = 1;
+      --p->refs;
+      p = copy_of_p;
+      return p;
+   }
+
+   chunked_sequence::node* chunked_sequence::insert_at(node*& p,
+      size_type position, const value_type& entry)
+   {
+      unshare(p);
+
+      if (p->is_chunk)
+      {
+         chunk* c = static_cast<chunk*>(p);
+         chunk* right = NULL;
+         chunk* target = c;
+
+         // Splitting a full chunk in half, then inserting into the half
+         // that position falls in
+         if (c->n == CHUNK_CAPACITY)
+         {
+            size_type half = c->n / 2;
+            right = new chunk;
+            right->refs = 1;
+            right->is_chunk = true;
+            right->n = right->count = c->n - half;
+            copy(c->items + half, c->items + c->n, right->items);
+            c->n = c->count = half;
+            if (position > half)
+            {
+               target = right;
+               position -= half;
+            }
+         }
+
+         copy_backward(target->items + position, target->items + target->n,
+                       target->items + target->n + 1);
+         target->items[position] = entry;
+         ++target->n;
+         ++target->count;
+         return right;
+      }
+
+      inner* q = static_cast<inner*>(p);
+
+      // Finding the child to insert into (the end of a child is taken
+      // as belonging to it, so attaching at the end needs no new chunk)
+      size_type i = 0;
+      while (i + 1 < q->n && position > q->children[i]->count)
+      {
+         position -= q->children[i]->count;
+         ++i;
+      }
+      node* split = insert_at(q->children[i], position, entry);
+      ++q->count;
+      if (split == NULL)
+      {
+         return NULL;
+      }
+
+      // Adding the child's new sibling just after it, splitting this
+      // node first if it is full (split's items are counted in q->count
+      // again once split is added to the node it goes into)
+      q->count -= split->count;
+      inner* right = NULL;
+      inner* target = q;
+      size_type at = i + 1;
+      if (q->n == FANOUT)
+      {
+         size_type half = q->n / 2;
+         right = new inner;
+         right->refs = 1;
+         right->is_chunk = false;
+         right->n = q->n - half;
+         right->count = 0;
+         for (size_type k = half; k < q->n; ++k)
+         {
+            right->children[k - half] = q->children[k];
+            right->count += q->children[k]->count;
+         }
+         q->n = half;
+         q->count -= right->count;
+         if (at > half)
+         {
+            target = right;
+            at -= half;
+         }
+      }
+
+      copy_backward(target->children + at, target->children + target->n,
+                    target->children + target->n + 1);
+      target->children[at] = split;
+      ++target->n;
+      target->count += split->count;
+      return right;
+   }
+
+   void chunked_sequence::erase_at(node*& p, size_type position)
+   {
+      unshare(p);
+
+      if (p->is_chunk)
+      {
+         chunk* c = static_cast<chunk*>(p);
+         copy(c->items + position + 1, c->items + c->n, c->items + position);
+         --c->n;
+         --c->count;
+         return;
+      }
+
+      inner* q = static_cast<inner*>(p);
+      size_type i = 0;
+      while (position >= q->children[i]->count)
+      {
+         position -= q->children[i]->count;
+         ++i;
+      }
+      erase_at(q->children[i], position);
+      --q->count;
+
+      node* child = q->children[i];
+      size_type capacity = child->is_chunk ? CHUNK_CAPACITY : FANOUT;
+      if (child->n == 0)
+      {
+         // Dropping the emptied child
+         release(child);
+         copy(q->children + i + 1, q->children + q->n, q->children + i);
+         --q->n;
+      }
+      else if (child->n < capacity / 4 && q->n > 1)
+      {
+         // Merging an underfull child with a neighbor if they fit
+         size_type left = (i + 1 < q->n) ? i : i - 1;
+         if (q->children[left]->n + q->children[left + 1]->n <= capacity)
+         {
+            merge_children(q, left);
+         }
+      }
+   }
+
+   void chunked_sequence::merge_children(inner* parent, size_type i)
+   {
+      node* left = unshare(parent->children[i]);
+      node* right = parent->children[i + 1];
+
+      if (left->is_chunk)
+      {
+         const chunk* from = static_cast<const chunk*>(right);
+         chunk* to = static_cast<chunk*>(left);
+         copy(from->items, from->items + from->n, to->items + to->n);
+      }
+      else
+      {
+         // The moved children gain left as a parent; releasing right
+         // below drops right's references to them
+         const inner* from = static_cast<const inner*>(right);
+         inner* to = static_cast<inner*>(left);
+         for (size_type k = 0; k < from->n; ++k)
+         {
+            to->children[to->n + k] = from->children[k];
+            ++from->children[k]->refs;
+         }
+      }
+      left->n += right->n;
+      left->count += right->count;
+
+      release(right);
+      copy(parent->children + i + 2, parent->children + parent->n,
+           parent->children + i + 1);
+      --parent->n;
+   }
+
+   const chunked_sequence::chunk* chunked_sequence::find_chunk(
+      size_type position, size_type& first) const
+   {
+      const node* p = root;
+      first = 0;
+      while (!p->is_chunk)
+      {
+         const inner* q = static_cast<const inner*>(p);
+         size_type i = 0;
+         while (position >= first + q->children[i]->count)
+         {
+            first += q->children[i]->count;
+            ++i;
+         }
+         p = q->children[i];
+      }
+      return static_cast<const chunk*>(p);
+   }
+
+   void chunked_sequence::insert_item(size_type position,
+                                      const value_type& entry)
+   {
+      cached_chunk = NULL;
+
+      if (root == NULL)
+      {
+         chunk* c = new chunk;
+         c->refs = 1;
+         c->count = c->n = 0;
+         c->is_chunk = true;
+         root = c;
+      }
+
+      // A split root gets a new root above it and its new sibling
+      node* split = insert_at(root, position, entry);
+      if (split != NULL)
+      {
+         inner* new_root = new inner;
+         new_root->refs = 1;
+         new_root->is_chunk = false;
+         new_root->n = 2;
+         new_root->children[0] = root;
+         new_root->children[1] = split;
+         new_root->count = root->count + split->count;
+         root = new_root;
+      }
+   }
+
+   // CONSTRUCTORS and DESTRUCTOR
+   chunked_sequence::chunked_sequence(size_type initial_capacity)
+   : root(NULL), current_index(0), cached_chunk(NULL), cached_first(0)
+   {
+      // Chunks are allocated as needed (see ChunkedSequence.h)
+      (void) initial_capacity;
+   }
+
+   chunked_sequence::chunked_sequence(const chunked_sequence& source)
+   : root(source.root), current_index(source.current_index),
+   cached_chunk(NULL), cached_first(0)
+   {
+      // Sharing source's tree; the first change to either sequence
+      // copies the nodes it touches
+      if (root != NULL)
+      {
+         ++root->refs;
+      }
+   }
+
+   chunked_sequence::chunked_sequence(chunked_sequence&& source) noexcept
+   : root(source.root), current_index(source.current_index),
+   cached_chunk(source.cached_chunk), cached_first(source.cached_first)
+   {
+      source.root = NULL;
+      source.current_index = 0;
+      source.cached_chunk = NULL;
+   }
+
+   chunked_sequence::~chunked_sequence()
+   {
+      release(root);
+      root = NULL;
+   }
+
+   // MODIFICATION MEMBER FUNCTIONS
+   void chunked_sequence::resize(size_type new_capacity)
+   {
+      // Nothing to do: chunks are allocated as needed
+      (void) new_capacity;
+   }
+
+   void chunked_sequence::start()
+   {
+      current_index = 0;
+   }
+
+   void chunked_sequence::advance()
+   {
+      assert(is_item());
+      ++current_index;
+   }
+
+   void chunked_sequence::insert(const value_type& entry)
+   {
+      // Inserting at current_index (at the front if there is no
+      // current item); the new item becomes current where it is
+      if (!is_item())
+      {
+         current_index = 0;
+      }
+      insert_item(current_index, entry);
+   }
+
+   void chunked_sequence::attach(const value_type& entry)
+   {
+      // Inserting after the current item (at the end, where
+      // current_index already is, if there is no current item)
+      if (is_item())
+      {
+         ++current_index;
+      }
+      insert_item(current_index, entry);
+   }
+
+   void chunked_sequence::remove_current()
+   {
+      assert(is_item());
+      cached_chunk = NULL;
+
+      erase_at(root, current_index);
+
+      // Removing the tree once empty, and any root left with only one
+      // child (keeping the child, which the old root shared)
+      if (root->count == 0)
+      {
+         release(root);
+         root = NULL;
+      }
+      else if (!root->is_chunk && root->n == 1)
+      {
+         node* child = static_cast<inner*>(root)->children[0];
+         ++child->refs;
+         release(root);
+         root = child;
+      }
+   }
+
+   chunked_sequence& chunked_sequence::operator=(chunked_sequence source)
+      noexcept
+   {
+      swap(source);
+      return *this;
+   }
+
+   void chunked_sequence::swap(chunked_sequence& other) noexcept
+   {
+      std::swap(root, other.root);
+      std::swap(current_index, other.current_index);
+      std::swap(cached_chunk, other.cached_chunk);
+      std::swap(cached_first, other.cached_first);
+   }
+
+   // CONSTANT MEMBER FUNCTIONS
+   chunked_sequence::size_type chunked_sequence::size() const
+   {
+      return (root == NULL) ? 0 : root->count;
+   }
+
+   bool chunked_sequence::is_item() const
+   {
+      return current_index < size();
+   }
+
+   chunked_sequence::value_type chunked_sequence::current() const
+   {
+      assert(is_item());
+
+      // Looking the chunk up again only when the cursor has left it
+      if (cached_chunk == NULL || current_index < cached_first
+          || current_index >= cached_first + cached_chunk->n)
+      {
+         cached_chunk = find_chunk(current_index, cached_first);
+      }
+      return cached_chunk->items[current_index - cached_first];
+   }
+}
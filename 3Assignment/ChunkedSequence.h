@@ -0,0 +1,180 @@
+// FILE: ChunkedSequence.h
+// CLASS PROVIDED: chunked_sequence (part of the namespace CS3358_FA2019)
+//
+// chunked_sequence has the same interface and behavior as sequence (see
+// Sequence.h), and is meant for very long sequences (millions of
+// items). Instead of one dynamic array it stores the items in fixed-size
+// chunks of CHUNK_CAPACITY items, which are the leaves of a balanced
+// tree (a B+tree in which each node knows how many items lie below it):
+//   - insert, attach and remove_current find the cursor's chunk in
+//     O(log n) steps and shift at most one chunk's worth of items, so
+//     they cost O(log n) no matter how long the sequence is; a full
+//     chunk is split in two rather than the whole sequence reallocated.
+//   - start, advance and is_item are O(1); current is O(1) while the
+//     cursor stays in the chunk of the previous call, otherwise
+//     O(log n).
+//   - Copies share their chunks (and the nodes above them) with the
+//     source; a shared chunk or node is copied only when one of the
+//     sequences sharing it changes it (copy-on-write), so the copy
+//     constructor and assignment are O(1), and a change to one copy
+//     costs only the O(log n) nodes on the path to the changed chunk.
+//   NOTE: Sharing is not thread-safe: two chunked_sequences that share
+//         chunks must not be used by different threads at the same time.
+//
+// TYPEDEFS and MEMBER CONSTANTS for the chunked_sequence class:
+//   typedef ____ value_type
+//    chunked_sequence::value_type is the data type of the items in the
+//    sequence. It may be any of the C++ built-in types (int, char,
+//    etc.), or a class with a default constructor, an assignment
+//    operator, and a copy constructor.
+//
+//   typedef ____ size_type
+//    chunked_sequence::size_type is the data type of any variable that
+//    keeps track of how many items are in a sequence.
+//
+//   static const size_type DEFAULT_CAPACITY = _____
+//    Kept for compatibility with sequence; see the constructor.
+//
+//   static const size_type CHUNK_CAPACITY = _____
+//    chunked_sequence::CHUNK_CAPACITY is the most items one chunk holds.
+//
+//   static const size_type FANOUT = _____
+//    chunked_sequence::FANOUT is the most children one node of the tree
+//    above the chunks has.
+//
+// CONSTRUCTOR for the chunked_sequence class:
+//   chunked_sequence(size_type initial_capacity = DEFAULT_CAPACITY)
+//    Pre:  none
+//    Post: The sequence has been initialized as an empty sequence.
+//    Note: Chunks are allocated as they are needed, so initial_capacity
+//      is ignored (it is accepted so that chunked_sequence can replace
+//      sequence without changes to client code).
+//
+//   chunked_sequence(chunked_sequence&& source) noexcept
+//    Pre:  none
+//    Post: The sequence has taken over the items and current item of
+//      source without copying or allocating; source is left an empty
+//      sequence, which may still be added to, assigned to or destroyed.
+//
+// MODIFICATION MEMBER FUNCTIONS for the chunked_sequence class:
+//   void resize(size_type new_capacity)
+//    Pre:  none
+//    Post: The sequence is unchanged (there is no capacity to change;
+//      see the constructor).
+//
+//   void start()
+//    Pre:  none
+//    Post: The first item on the sequence becomes the current item
+//      (but if the sequence is empty, then there is no current item).
+//
+//   void advance()
+//    Pre:  is_item returns true.
+//    Post: If the current item was already the last item in the
+//      sequence, then there is no longer any current item. Otherwise,
+//      the new current item is the item immediately after the original
+//      current item.
+//
+//   void insert(const value_type& entry)
+//    Pre:  none
+//    Post: A new copy of entry has been inserted in the sequence
+//      before the current item. If there was no current item, then
+//      the new entry has been inserted at the front of the sequence.
+//      In either case, the newly inserted item is now the current item
+//      of the sequence.
+//
+//   void attach(const value_type& entry)
+//    Pre:  none
+//    Post: A new copy of entry has been inserted in the sequence after
+//      the current item. If there was no current item, then the new
+//      entry has been attached to the end of the sequence. In either
+//      case, the newly inserted item is now the current item of the
+//      sequence.
+//
+//   void remove_current()
+//    Pre:  is_item returns true.
+//    Post: The current item has been removed from the sequence, and
+//      the item after this (if there is one) is now the new current
+//      item. If the current item was already the last item in the
+//      sequence, then there is no longer any current item.
+//
+//   void swap(chunked_sequence& other) noexcept
+//    Pre:  none
+//    Post: The items and current items of the sequence and other have
+//      been exchanged; nothing is copied or allocated.
+//
+// CONSTANT MEMBER FUNCTIONS for the chunked_sequence class:
+//   size_type size() const
+//    Pre:  none
+//    Post: The return value is the number of items in the sequence.
+//
+//   bool is_item() const
+//    Pre:  none
+//    Post: A true return value indicates that there is a valid
+//      "current" item that may be retrieved by activating the current
+//      member function (listed below). A false return value indicates
+//      that there is no valid current item.
+//
+//   value_type current() const
+//    Pre:  is_item() returns true.
+//    Post: The item returned is the current item in the sequence.
+//
+// VALUE SEMANTICS for the chunked_sequence class:
+//   Assignments and the copy constructor may be used with
+//   chunked_sequence objects. Both are O(1): the new copy shares all
+//   chunks with its source until one of them is changed. Assignment
+//   takes its right-hand side by value (copy-and-swap).
+
+#ifndef CHUNKED_SEQUENCE_H
+#define CHUNKED_SEQUENCE_H
+#include <cstdlib>  // provides size_t
+
+namespace CS3358_FA2019
+{
+   class chunked_sequence
+   {
+   public:
+      // TYPEDEFS and MEMBER CONSTANTS
+      typedef double value_type;
+      typedef std::size_t size_type;
+      static const size_type DEFAULT_CAPACITY = 30;
+      static const size_type CHUNK_CAPACITY = 512;
+      static const size_type FANOUT = 64;
+      // CONSTRUCTORS and DESTRUCTOR
+      chunked_sequence(size_type initial_capacity = DEFAULT_CAPACITY);
+      chunked_sequence(const chunked_sequence& source);
+      chunked_sequence(chunked_sequence&& source) noexcept;
+      ~chunked_sequence();
+      // MODIFICATION MEMBER FUNCTIONS
+      void resize(size_type new_capacity);
+      void start();
+      void advance();
+      void insert(const value_type& entry);
+      void attach(const value_type& entry);
+      void remove_current();
+      chunked_sequence& operator=(chunked_sequence source) noexcept;
+      void swap(chunked_sequence& other) noexcept;
+      // CONSTANT MEMBER FUNCTIONS
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+   private:
+      struct node;
+      struct chunk;
+      struct inner;
+      node* root;
+      size_type current_index;
+      mutable const chunk* cached_chunk;
+      mutable size_type cached_first;
+      // HELPER FUNCTIONS
+      static void release(node* p);
+      static node* unshare(node*& p);
+      static node* insert_at(node*& p, size_type position,
+                             const value_type& entry);
+      static void erase_at(node*& p, size_type position);
+      static void merge_children(inner* parent, size_type i);
+      const chunk* find_chunk(size_type position, size_type& first) const;
+      void insert_item(size_type position, const value_type& entry);
+   };
+}
+
+#endif
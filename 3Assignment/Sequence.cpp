@@ -5,10 +5,20 @@
 //      used;
 //   2. The actual items of the sequence are stored in a partially
 //      filled array. The array is a dynamic array, pointed to by
-//      the member variable data. For an empty sequence, we do not
-//      care what is stored in any of data; for a non-empty sequence
-//      the items in the sequence are stored in data[0] through
-//      data[used-1], and we don't care what's in the rest of data.
+//      the member variable buffer. The capacity - used unused elements
+//      of buffer form one "gap" starting at buffer[g] (0 <= g <= used):
+//      the first g items of the sequence are stored in buffer[0] through
+//      buffer[g-1] and the rest in buffer[g + capacity - used] through
+//      buffer[capacity-1] (see physical). We don't care what's in the
+//      gap.
+//      2.1 When mode is CONTIGUOUS, g is always used, so the items are
+//          stored in buffer[0] through buffer[used-1]; gap_begin is not
+//          used (it stays 0).
+//      2.2 When mode is GAP_BUFFER, g is gap_begin: the gap is left
+//          wherever the last edit put it (at the cursor) and only
+//          moved by move_gap. Moving the gap doesn't change the
+//          sequence, so gap_begin is mutable and move_gap is constant
+//          (the constant data() closes the gap too).
 //   3. The size of the dynamic array is in the member variable
 //      capacity.
 //   4. The index of the current item is in the member variable
@@ -37,17 +47,99 @@
 //                postcondition for the function for both of the two
 //                possible scenarios (current item is and is not the
 //                last item in the sequence).
+//   5. A sequence that has been moved from owns no dynamic array: buffer
+//      is NULL and capacity (as well as used, current_index and
+//      gap_begin) is 0; insert/attach grow it again through resize
+//      like any full sequence.
+//   6. If stats_valid is true, cached_stats holds the statistics of the
+//      items as they are now (see SequenceStats.cpp). Every change to
+//      the items (insert_at, erase_at) sets stats_valid to false, and so
+//      does handing out write access to them (the non-constant
+//      items_begin, items_end and data), since the items may then be
+//      changed without the sequence knowing. Handing out write access
+//      also sets views_out to true, and stats only sets stats_valid
+//      while views_out is false: the iterators and pointers handed out
+//      stay usable until the next change that invalidates them
+//      (insert_at, erase_at or resize), which is the only place
+//      views_out is set back to false (swap and the move constructor
+//      carry it along with the dynamic array).
+//   7. Bookmark b (see set_bookmark) is set if b < bookmarks.size() and
+//      bookmarks[b] is not REMOVED_BOOKMARK; bookmarks[b] is then the
+//      position (0 .. used) of the item it is on. insert_at and erase_at
+//      keep the positions on their items. Slots of removed bookmarks are
+//      reused by set_bookmark, and trailing ones dropped by
+//      remove_bookmark.
+//
+// DOCUMENTATION for private member (helper) functions:
+//   size_type gap_start() const
+//    Post: The index in buffer where the gap starts (g of invariant 2) is
+//      returned.
+//
+//   size_type physical(size_type i) const
+//    Pre:  i < used
+//    Post: The index in buffer of the item at position i of the sequence
+//      is returned.
+//
+//   void move_gap(size_type position) const
+//    Pre:  mode == GAP_BUFFER and position <= used
+//    Post: The gap starts at buffer[position] (gap_begin == position);
+//      only the items between the old and new gap positions have been
+//      moved (across the gap), and the sequence is unchanged.
+//
+//   bool in_buffer(const value_type* p) const
+//    Pre:  none
+//    Post: true is returned if p points into buffer (an item of this
+//      sequence, or the gap), otherwise false is returned.
+//
+//   void make_room(size_type count)
+//    Pre:  none
+//    Post: capacity >= used + count. If the sequence had to be resized,
+//      the new capacity is the larger of used + count and 1.5 times the
+//      old capacity plus 1 (so repeated growth is geometric).
+//
+//   void insert_at(size_type position, const value_type* first,
+//                  const value_type* last)
+//    Pre:  position <= used; used + (last - first) <= capacity;
+//      [first, last) does not lie within buffer.
+//    Post: The items in [first, last) have been inserted, in order, at
+//      position of the sequence with one shift of the items from
+//      position on (last - first positions later); used has been
+//      increased by last - first. current_index is unchanged, set
+//      bookmarks are still on their items, and stats_valid is false.
+//
+//   void erase_at(size_type position)
+//    Pre:  position < used
+//    Post: The item at position of the sequence has been removed (later
+//      items are one position earlier); used has been decremented.
+//      current_index is unchanged, set bookmarks on later items are one
+//      position earlier, and stats_valid is false.
+//
+//   bool is_bookmark(bookmark b) const
+//    Pre:  none
+//    Post: true is returned if bookmark b is set (invariant 7).
 
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <string>
 #include "Sequence.h"
+#include "SequenceFile.h"
 #include <iostream>
+#include <vector>
+#include <utility>
 using namespace std;
 
 namespace CS3358_FA2019
 {
+   // Marks the slot of a removed bookmark (no position is this large)
+   const sequence::size_type REMOVED_BOOKMARK = sequence::size_type(-1);
+
    // CONSTRUCTORS and DESTRUCTOR
-   sequence::sequence(size_type initial_capacity) : used(0), current_index(0),
-   capacity(initial_capacity)
+   sequence::sequence(size_type initial_capacity, storage_mode initial_mode)
+   : used(0), current_index(0), capacity(initial_capacity), gap_begin(0),
+   mode(initial_mode), cached_stats(), stats_valid(false), views_out(false)
    {
       // Verifying pre-condition: initial_capacity > 0
       if (initial_capacity < 1)
@@ -56,32 +148,56 @@ namespace CS3358_FA2019
       }
 
       // Creating new empty dynamic array of size 'capacity'
-      data = new value_type[capacity];
+      buffer = new value_type[capacity];
    }
 
    sequence::sequence(const sequence& source) : used(source.used),
-   current_index(source.current_index), capacity(source.capacity)
+   current_index(source.current_index), capacity(source.capacity),
+   gap_begin(source.gap_begin), mode(source.mode),
+   cached_stats(source.cached_stats), stats_valid(source.stats_valid),
+   views_out(false), bookmarks(source.bookmarks)
    {
       // Creating new empty dynamic array of size 'capacity'
-      data = new value_type[capacity];
+      buffer = new value_type[capacity];
 
-      // Copying over all elements from 'source'
-      for (size_type i = 0; i < used; i++)
-      {
-         data[i] = source.data[i];
-      }
+      // Copying over the items on both sides of the gap from 'source'
+      // (the gap stays where it is)
+      size_type front = source.gap_start();
+      copy(source.buffer, source.buffer + front, buffer);
+      copy(source.buffer + front + (capacity - used),
+           source.buffer + capacity, buffer + front + (capacity - used));
+   }
+
+   sequence::sequence(sequence&& source) noexcept : buffer(source.buffer),
+   used(source.used), current_index(source.current_index),
+   capacity(source.capacity), gap_begin(source.gap_begin),
+   mode(source.mode), cached_stats(source.cached_stats),
+   stats_valid(source.stats_valid), views_out(source.views_out),
+   bookmarks(std::move(source.bookmarks))
+   {
+      // Taking over source's dynamic array and leaving source without one
+      source.buffer = NULL;
+      source.used = 0;
+      source.current_index = 0;
+      source.capacity = 0;
+      source.gap_begin = 0;
+      source.stats_valid = false;
+      source.views_out = false;
+      source.bookmarks.clear();
    }
 
    sequence::~sequence()
    {
       // Deallocating dynamic variables
-      delete [] data;
-      data = NULL;
+      delete [] buffer;
+      buffer = NULL;
    }
 
    // MODIFICATION MEMBER FUNCTIONS
    void sequence::resize(size_type new_capacity)
    {
+      size_type old_capacity = capacity;
+
       // Checking Pre-condition
       if (used != 0 && new_capacity < used)
       {
@@ -99,16 +215,19 @@ namespace CS3358_FA2019
       // Creating temp dynamic array with new capacity value
       value_type * temp_data = new value_type[capacity];
 
-      // Copying contents from 'data' to new resized array
-      for (size_type i = 0; i < used; i++)
-      {
-         temp_data[i] = data[i];
-      }
+      // Copying contents from 'buffer' to new resized array: the items
+      // before the gap to the front, the items after it to the back
+      size_type front = gap_start();
+      size_type after_gap = used - front;
+      copy(buffer, buffer + front, temp_data);
+      copy(buffer + old_capacity - after_gap, buffer + old_capacity,
+           temp_data + capacity - after_gap);
 
-      // Deallocating old dynamic variable 'data' and assigning 'data' to new
-      // resized dynamic array
-      delete [] data;
-      data = temp_data;
+      // Deallocating old dynamic variable 'buffer' and assigning 'buffer'
+      // to new resized dynamic array
+      delete [] buffer;
+      buffer = temp_data;
+      views_out = false;
    }
 
    void sequence::start()
@@ -125,61 +244,159 @@ namespace CS3358_FA2019
       current_index = current_index + 1;
    }
 
-   void sequence::insert(const value_type& entry)
+   void sequence::end()
    {
-      // If sequence at capacity then resize
-      if (used == capacity)
-      {
-         resize(size_type ((capacity * 1.5) + 1));
-      }
+      // The last item becomes current; for an empty sequence used - 1
+      // would wrap around, so there is no current item instead
+      current_index = (used == 0) ? 0 : used - 1;
+   }
 
-      // Inserting new entry at current_index and shifting elements to the right
-      if (is_item())
+   void sequence::move_back()
+   {
+      // Validating pre-condition
+      assert(is_item());
+
+      // Moving back from the first item leaves no current item
+      current_index = (current_index == 0) ? used : current_index - 1;
+   }
+
+   void sequence::seek(size_type index)
+   {
+      // Validating pre-condition
+      assert(index <= used);
+
+      current_index = index;
+   }
+
+   sequence::bookmark sequence::set_bookmark()
+   {
+      // Reusing the slot of a removed bookmark if there is one
+      for (bookmark b = 0; b < bookmarks.size(); ++b)
       {
-         for (size_type i = used; i > current_index; --i)
+         if (bookmarks[b] == REMOVED_BOOKMARK)
          {
-            data[i] = data[i - 1];
+            bookmarks[b] = current_index;
+            return b;
          }
       }
-      else
+      bookmarks.push_back(current_index);
+      return bookmarks.size() - 1;
+   }
+
+   void sequence::go_to_bookmark(bookmark b)
+   {
+      // Validating pre-condition
+      assert(is_bookmark(b));
+
+      current_index = bookmarks[b];
+   }
+
+   void sequence::remove_bookmark(bookmark b)
+   {
+      // Validating pre-condition
+      assert(is_bookmark(b));
+
+      // Freeing the slot, and dropping free slots at the end so that
+      // edits don't keep checking them
+      bookmarks[b] = REMOVED_BOOKMARK;
+      while (!bookmarks.empty() && bookmarks.back() == REMOVED_BOOKMARK)
       {
-         current_index = 0;
-         for (size_type i = used; i > current_index; --i)
-         {
-            data[i] = data[i - 1];
-         }
+         bookmarks.pop_back();
       }
+   }
 
-      data[current_index] = entry;
-      ++used;
+   void sequence::insert(const value_type& entry)
+   {
+      insert_range(&entry, &entry + 1);
    }
 
    void sequence::attach(const value_type& entry)
    {
-      // If sequence is not empty
-      if ( current_index != used)
+      attach_range(&entry, &entry + 1);
+   }
+
+   void sequence::insert_range(const value_type* first,
+                               const value_type* last)
+   {
+      if (first == last)
       {
-         // If sequence at capacity then resize
-         if (used == capacity)
-         {
-            resize(size_type ((capacity * 1.5) + 1));
-         }
+         return;
+      }
+      if (in_buffer(first))
+      {
+         // Copying out a range of this sequence's own items, which
+         // making room could move
+         vector<value_type> copy_of_range(first, last);
+         insert_range(&copy_of_range[0], &copy_of_range[0] + (last - first));
+         return;
+      }
 
-         // Inserting new entry after current_index and shifting elements to the right
-         current_index = current_index + 1;
-         for (size_type i = used; i > current_index; --i)
-         {
-            data[i] = data[i - 1];
-         }
-         data[current_index] = entry;
+      // If sequence too full then resize (once for the whole range)
+      make_room(last - first);
+
+      // Inserting the new entries at current_index (at the front if
+      // there is no current item); the first of them becomes current
+      if (!is_item())
+      {
+         current_index = 0;
       }
-      else
+      insert_at(current_index, first, last);
+   }
+
+   void sequence::attach_range(const value_type* first,
+                               const value_type* last)
+   {
+      if (first == last)
+      {
+         return;
+      }
+      if (in_buffer(first))
+      {
+         vector<value_type> copy_of_range(first, last);
+         attach_range(&copy_of_range[0], &copy_of_range[0] + (last - first));
+         return;
+      }
+
+      // If sequence too full then resize (also when there is no
+      // current item, since the entries then go at the end)
+      make_room(last - first);
+
+      // Inserting the new entries after current_index (at the end if
+      // there is no current item, where current_index already is); the
+      // last of them becomes current
+      if (is_item())
       {
-         data[current_index] = entry;
+         current_index = current_index + 1;
       }
+      insert_at(current_index, first, last);
+      current_index += (last - first) - 1;
+   }
 
-      ++used;
+   sequence::iterator sequence::items_begin()
+   {
+      stats_valid = false;
+      views_out = true;
+      return iterator(buffer, gap_start(), capacity - used, 0);
+   }
 
+   sequence::iterator sequence::items_end()
+   {
+      stats_valid = false;
+      views_out = true;
+      return iterator(buffer, gap_start(), capacity - used, used);
+   }
+
+   sequence::value_type* sequence::data()
+   {
+      stats_valid = false;
+      views_out = true;
+
+      // Closing the gap (moving it past the last item)
+      if (mode == GAP_BUFFER)
+      {
+         move_gap(used);
+      }
+      return buffer;
    }
 
    void sequence::remove_current()
@@ -187,43 +404,166 @@ namespace CS3358_FA2019
       // Validating pre-condition
       assert(is_item());
 
-      // Removing current item and shifting everything to the left
-      for (size_type i = current_index; i < used - 1; i++)
+      // Removing current item; the item after it (if any) takes its
+      // position and so becomes current
+      erase_at(current_index);
+   }
+
+   void sequence::move_gap(size_type position) const
+   {
+      size_type gap_size = capacity - used;
+
+      if (position < gap_begin)
+      {
+         // Items position .. gap_begin-1 move to just below the gap's end
+         copy_backward(buffer + position, buffer + gap_begin,
+                       buffer + gap_begin + gap_size);
+      }
+      else if (position > gap_begin)
       {
-         data[i] = data[i + 1];
+         // Items just above the gap move down to its beginning
+         copy(buffer + gap_begin + gap_size, buffer + position + gap_size,
+              buffer + gap_begin);
       }
+      gap_begin = position;
+   }
 
-      // Reducing used count by one
-      --used;
+   bool sequence::in_buffer(const value_type* p) const
+   {
+      // std::less gives a total order even for unrelated pointers
+      return !less<const value_type*>()(p, buffer)
+             && less<const value_type*>()(p, buffer + capacity);
+   }
+
+   void sequence::make_room(size_type count)
+   {
+      if (used + count > capacity)
+      {
+         resize(max(used + count, size_type ((capacity * 1.5) + 1)));
+      }
+   }
+
+   void sequence::insert_at(size_type position, const value_type* first,
+                            const value_type* last)
+   {
+      size_type count = last - first;
+
+      stats_valid = false;
+      views_out = false;
+      if (mode == GAP_BUFFER)
+      {
+         // Filling the front of the gap moved to position
+         move_gap(position);
+         copy(first, last, buffer + gap_begin);
+         gap_begin += count;
+      }
+      else
+      {
+         // Shifting the items from position on count places to the
+         // right, then copying the new entries into the opening
+         copy_backward(buffer + position, buffer + used,
+                       buffer + used + count);
+         copy(first, last, buffer + position);
+      }
+      used += count;
+
+      // Keeping bookmarks on their items (a bookmark past the last item
+      // stays past it)
+      for (bookmark b = 0; b < bookmarks.size(); ++b)
+      {
+         if (bookmarks[b] != REMOVED_BOOKMARK && bookmarks[b] >= position)
+         {
+            bookmarks[b] += count;
+         }
+      }
    }
 
-   sequence& sequence::operator=(const sequence& source)
+   void sequence::erase_at(size_type position)
    {
-      if (!(this == &source))
+      stats_valid = false;
+      views_out = false;
+      if (mode == GAP_BUFFER)
+      {
+         // With the gap at position, the item there is the first one
+         // after the gap; widening the gap by one drops it
+         move_gap(position);
+      }
+      else
       {
-         // Allocating space in temp_data to hold elements in source
-         value_type * temp_data = new value_type[source.capacity];
+         // Shifting the items after position one place to the left
+         copy(buffer + position + 1, buffer + used, buffer + position);
+      }
+      --used;
 
-         // Copying over source array elements into temp_data array
-         for (size_type i = 0; i < source.used; i++)
+      // Bookmarks on later items follow them; one on the removed item
+      // is now on the item after it
+      for (bookmark b = 0; b < bookmarks.size(); ++b)
+      {
+         if (bookmarks[b] != REMOVED_BOOKMARK && bookmarks[b] > position)
          {
-            temp_data[i] = source.data[i];
+            --bookmarks[b];
          }
+      }
+   }
 
-         // Deallocating dynamic array currently pointed at by data
-         delete [] data;
+   bool sequence::load(const char file_name[])
+   {
+      ifstream in(file_name, ios::binary);
+      sequence_file_header header;
 
-         // Assigning data to temp_data array
-         data = temp_data;
+      // Reading and checking the header against the file's size
+      if (!in.seekg(0, ios::end))
+      {
+         return false;
+      }
+      streamoff file_size = in.tellg();
+      in.seekg(0);
+      if (file_size < 0
+          || !in.read(reinterpret_cast<char*>(&header), sizeof(header))
+          || !check_header(header, file_size))
+      {
+         return false;
+      }
 
-         // Reflecting source properties onto this
-         used = source.used;
-         current_index = source.current_index;
-         capacity = source.capacity;
+      // Reading the items into a new sequence with the gap (if any) after
+      // them, then trading contents with it
+      sequence loaded(header.count, mode);
+      if (header.count > 0
+          && !in.read(reinterpret_cast<char*>(loaded.buffer),
+                      header.count * sizeof(value_type)))
+      {
+         return false;
       }
+      loaded.used = header.count;
+      loaded.current_index = header.current_index;
+      loaded.gap_begin = (mode == GAP_BUFFER) ? loaded.used : 0;
+      swap(loaded);
+      return true;
+   }
+
+   sequence& sequence::operator=(sequence source) noexcept
+   {
+      // source is already a copy of (or was moved from) the right-hand
+      // side; trading contents with it hands the old array to source's
+      // destructor (self-assignment needs no special case)
+      swap(source);
       return *this;
    }
 
+   void sequence::swap(sequence& other) noexcept
+   {
+      std::swap(buffer, other.buffer);
+      std::swap(used, other.used);
+      std::swap(current_index, other.current_index);
+      std::swap(capacity, other.capacity);
+      std::swap(gap_begin, other.gap_begin);
+      std::swap(mode, other.mode);
+      std::swap(cached_stats, other.cached_stats);
+      std::swap(stats_valid, other.stats_valid);
+      std::swap(views_out, other.views_out);
+      bookmarks.swap(other.bookmarks);
+   }
+
    // CONSTANT MEMBER FUNCTIONS
    sequence::size_type sequence::size() const
    {
@@ -232,6 +572,24 @@ namespace CS3358_FA2019
       return used;
    }
 
+   sequence::size_type sequence::position() const
+   {
+      return current_index;
+   }
+
+   sequence::size_type sequence::bookmark_position(bookmark b) const
+   {
+      // Validating pre-condition
+      assert(is_bookmark(b));
+
+      return bookmarks[b];
+   }
+
+   sequence::storage_mode sequence::storage() const
+   {
+      return mode;
+   }
+
    bool sequence::is_item() const
    {
       // Returning true if current_index != used
@@ -242,6 +600,75 @@ namespace CS3358_FA2019
    {
       // Validating pre-condition
       assert(is_item());
-      return data[current_index];
+      return buffer[physical(current_index)];
+   }
+
+   sequence::const_iterator sequence::items_begin() const
+   {
+      return const_iterator(buffer, gap_start(), capacity - used, 0);
+   }
+
+   sequence::const_iterator sequence::items_end() const
+   {
+      return const_iterator(buffer, gap_start(), capacity - used, used);
+   }
+
+   const sequence::value_type* sequence::data() const
+   {
+      // Closing the gap (moving it past the last item); the items keep
+      // their values, so the cached statistics stay valid
+      if (mode == GAP_BUFFER)
+      {
+         move_gap(used);
+      }
+      return buffer;
+   }
+
+   bool sequence::save(const char file_name[]) const
+   {
+      string temp_name = string(file_name) + ".tmp";
+      sequence_file_header header;
+      size_type front = gap_start();
+
+      // Writing the header, then the items on both sides of the gap
+      fill_header(header, used, current_index);
+      {
+         ofstream out(temp_name.c_str(), ios::binary | ios::trunc);
+         out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+         out.write(reinterpret_cast<const char*>(buffer),
+                   front * sizeof(value_type));
+         out.write(reinterpret_cast<const char*>(buffer + physical(front)),
+                   (used - front) * sizeof(value_type));
+         out.close();
+         if (!out)
+         {
+            remove(temp_name.c_str());
+            return false;
+         }
+      }
+
+      // Replacing file_name with the complete snapshot
+      if (rename(temp_name.c_str(), file_name) != 0)
+      {
+         remove(temp_name.c_str());
+         return false;
+      }
+      return true;
+   }
+
+   sequence::size_type sequence::gap_start() const
+   {
+      return (mode == GAP_BUFFER) ? gap_begin : used;
+   }
+
+   sequence::size_type sequence::physical(size_type i) const
+   {
+      // Items at or after the gap are stored capacity - used further on
+      return (i < gap_start()) ? i : i + (capacity - used);
+   }
+
+   bool sequence::is_bookmark(bookmark b) const
+   {
+      return b < bookmarks.size() && bookmarks[b] != REMOVED_BOOKMARK;
    }
 }
@@ -16,14 +16,73 @@
 //    sequence::DEFAULT_CAPACITY is the default initial capacity of a
 //    sequence that is created by the default constructor.
 //
+//   typedef ____ iterator
+//   typedef ____ const_iterator
+//    Random-access iterators over the items of a sequence, from the
+//    first to the last (iterator gives read/write access, const_iterator
+//    read-only access; an iterator converts to a const_iterator). They
+//    meet the standard RandomAccessIterator requirements, so standard
+//    algorithms such as std::sort, std::accumulate and std::reduce can
+//    be run on [items_begin(), items_end()). (They are not named begin
+//    and end, since end moves the cursor.) Any change to
+//    the sequence other than through an iterator (insert, attach,
+//    remove_current, resize, data, assignment, ...) invalidates all
+//    iterators.
+//
+//   enum storage_mode { CONTIGUOUS, GAP_BUFFER }
+//    sequence::storage_mode selects how the items are laid out in the
+//    sequence's dynamic array:
+//    CONTIGUOUS - the items fill the front of the array; insert, attach
+//      and remove_current shift every item after the cursor (O(n)
+//      per edit).
+//    GAP_BUFFER - the unused part of the array is a "gap" kept where
+//      the last edit was made, with the items before it at the front
+//      of the array and the items after it at the back. An edit first
+//      moves the gap to the cursor (shifting only the items between
+//      the old and new positions), then fills or widens it in O(1),
+//      so a run of edits at or near the cursor costs amortized O(1)
+//      each.
+//    The mode affects only performance; the items (and the behavior
+//    of every member function) are the same either way.
+//
+//   struct statistics
+//    sequence::statistics holds summary statistics of the items of a
+//    sequence (see stats):
+//      size_type count     - the number of items
+//      value_type sum      - the sum of the items
+//      value_type min, max - the smallest and the largest item
+//      value_type mean     - sum / count
+//      value_type variance - the population variance (the mean of the
+//                            squared differences from mean)
+//    For an empty sequence count and sum are 0, and min, max, mean and
+//    variance are NaN.
+//
+//   typedef ____ bookmark
+//    sequence::bookmark identifies a bookmark: a second cursor, which
+//    stays on the item it was set on while items are inserted and
+//    removed around it (see set_bookmark).
+//
+//   static const size_type STATS_MIN_PER_THREAD = _____
+//    sequence::STATS_MIN_PER_THREAD is the fewest items stats gives each
+//    thread; shorter sequences are handled by the calling thread alone.
+//
 // CONSTRUCTOR for the sequence class:
-//   sequence(size_type initial_capacity = DEFAULT_CAPACITY)
+//   sequence(size_type initial_capacity = DEFAULT_CAPACITY,
+//            storage_mode mode = CONTIGUOUS)
 //    Pre:  initial_capacity > 0
-//    Post: The sequence has been initialized as an empty sequence.
+//    Post: The sequence has been initialized as an empty sequence
+//      with the given storage mode.
 //      The insert/attach functions will work efficiently (without
 //      allocating new memory) until this capacity is reached.
 //    Note: If Pre is not met, initial_capacity will be adjusted to 1.
 //
+//   sequence(sequence&& source) noexcept
+//    Pre:  none
+//    Post: The sequence has taken over the items, current item and
+//      dynamic array of source without copying or allocating; source
+//      is left an empty sequence with no dynamic array (capacity 0),
+//      which may still be added to, assigned to or destroyed.
+//
 // MODIFICATION MEMBER FUNCTIONS for the sequence class:
 //   void resize(size_type new_capacity)
 //    Pre:  new_capacity > 0
@@ -47,6 +106,47 @@
 //      the new current item is the item immediately after the original
 //      current item.
 //
+//   void end()
+//    Pre:  none
+//    Post: The last item on the sequence becomes the current item
+//      (but if the sequence is empty, then there is no current item).
+//
+//   void move_back()
+//    Pre:  is_item returns true.
+//    Post: If the current item was the first item in the sequence, then
+//      there is no longer any current item. Otherwise, the new current
+//      item is the item immediately before the original current item.
+//
+//   void seek(size_type index)
+//    Pre:  index <= size()
+//    Post: The item at position index (counting from 0) becomes the
+//      current item; if index is size(), there is no current item.
+//    Note: start, end, advance, move_back and seek are all O(1).
+//
+//   bookmark set_bookmark()
+//    Pre:  none
+//    Post: A new bookmark has been set on the current item (or, if there
+//      is no current item, just past the last item) and is returned.
+//      Until it is removed, the bookmark stays on that item as items are
+//      inserted and removed before it; if the item itself is removed,
+//      the bookmark moves to the item after it (or past the last item),
+//      as the current item would. A bookmark past the last item stays
+//      there. A bookmark belongs to the sequence's items: copies and
+//      assignments of the sequence copy it, and swap and load exchange
+//      or drop it with the items.
+//    Note: Every insert, attach and remove_current updates each bookmark
+//      that is set, so keep only the bookmarks still needed.
+//
+//   void go_to_bookmark(bookmark b)
+//    Pre:  b was returned by set_bookmark and has not been removed.
+//    Post: The item b is on becomes the current item (if b is past the
+//      last item, there is no current item).
+//
+//   void remove_bookmark(bookmark b)
+//    Pre:  b was returned by set_bookmark and has not been removed.
+//    Post: b has been removed (its number may be returned again by a
+//      later set_bookmark).
+//
 //   void insert(const value_type& entry)
 //    Pre:  none
 //    Post: A new copy of entry has been inserted in the sequence
@@ -63,6 +163,28 @@
 //      case, the newly inserted item is now the current item of the
 //      sequence.
 //
+//   void insert_range(const value_type* first, const value_type* last)
+//    Pre:  [first, last) is a valid range of value_type items.
+//    Post: Copies of the items in [first, last) have been inserted, in
+//      order, before the current item (at the front of the sequence if
+//      there was no current item), and the first of them is now the
+//      current item; the result is the same as inserting the items one
+//      at a time from last to first. If the range is empty, the
+//      sequence is unchanged.
+//    Note: The items after the insertion point are shifted only once,
+//      and the sequence is resized at most once, so inserting k items
+//      costs O(size() + k) rather than O(size() * k).
+//
+//   void attach_range(const value_type* first, const value_type* last)
+//    Pre:  [first, last) is a valid range of value_type items.
+//    Post: Copies of the items in [first, last) have been inserted, in
+//      order, after the current item (at the end of the sequence if
+//      there was no current item), and the last of them is now the
+//      current item; the result is the same as attaching the items one
+//      at a time from first to last. If the range is empty, the
+//      sequence is unchanged.
+//    Note: As for insert_range, this costs O(size() + k) for k items.
+//
 //   void remove_current()
 //    Pre:  is_item returns true.
 //    Post: The current item has been removed from the sequence, and
@@ -70,11 +192,59 @@
 //      item. If the current item was already the last item in the
 //      sequence, then there is no longer any current item.
 //
+//   iterator items_begin()
+//   iterator items_end()
+//    Pre:  none
+//    Post: An iterator to the first item (items_begin) or just past the
+//      last item (items_end) is returned; if the sequence is empty, the
+//      two are equal.
+//
+//   value_type* data()
+//    Pre:  none
+//    Post: The items are stored contiguously (in GAP_BUFFER mode the
+//      gap is moved to the end) and a pointer to the first of them is
+//      returned: data()[0] through data()[size()-1] are the items in
+//      order, and may be changed in place (for SIMD loops and other
+//      code that needs a plain array). The pointer stays valid until
+//      the next change to the sequence other than through it.
+//
+//   bool load(const char file_name[])
+//    Pre:  none
+//    Post: If file_name is a snapshot written by save (see
+//      SequenceFile.h), the items and current item of the sequence are
+//      now the ones saved there, its capacity is the number of items (or
+//      1 if there are none), it has no bookmarks, and true is returned;
+//      the storage mode is unchanged. Otherwise (no such file, a bad or truncated snapshot,
+//      or a read error) false is returned and the sequence is unchanged.
+//    Note: The items are read into the new dynamic array in one read
+//      (to share the pages of a snapshot between processes without
+//      copying it, use sequence_view from SequenceView.h).
+//
+//   void swap(sequence& other) noexcept
+//    Pre:  none
+//    Post: The items and current items of the sequence and other
+//      (together with the dynamic arrays holding them) have been
+//      exchanged; nothing is copied or allocated.
+//
 // CONSTANT MEMBER FUNCTIONS for the sequence class:
 //   size_type size() const
 //    Pre:  none
 //    Post: The return value is the number of items in the sequence.
 //
+//   size_type position() const
+//    Pre:  none
+//    Post: The position of the current item (counting from 0) is
+//      returned; if there is no current item, size() is returned.
+//
+//   size_type bookmark_position(bookmark b) const
+//    Pre:  b was returned by set_bookmark and has not been removed.
+//    Post: The position of the item b is on (size() if b is past the
+//      last item) is returned.
+//
+//   storage_mode storage() const
+//    Pre:  none
+//    Post: The return value is the storage mode of the sequence.
+//
 //   bool is_item() const
 //    Pre:  none
 //    Post: A true return value indicates that there is a valid
@@ -86,13 +256,74 @@
 //    Pre:  is_item() returns true.
 //    Post: The item returned is the current item in the sequence.
 //
+//   const_iterator items_begin() const
+//   const_iterator items_end() const
+//    Pre:  none
+//    Post: As for the non-constant begin and end, but read-only.
+//
+//   const value_type* data() const
+//    Pre:  none
+//    Post: As for the non-constant data, but the pointer is read-only:
+//      in GAP_BUFFER mode the gap is moved to the end, and data()[0]
+//      through data()[size()-1] are the items in order.
+//    Note: Moving the gap changes only where the items are kept, so the
+//      sequence (and its cached statistics) is unchanged, but iterators
+//      made before the call are invalidated. Like stats, it must not be
+//      called on one sequence by two threads at the same time (unless
+//      storage() is CONTIGUOUS, where nothing is moved).
+//
+//   bool save(const char file_name[]) const
+//    Pre:  none
+//    Post: A snapshot of the items and current item (in the binary
+//      format of SequenceFile.h) has been written to file_name, and true
+//      is returned. The snapshot is written to file_name with ".tmp"
+//      added and then renamed to file_name, so file_name is replaced
+//      only by a complete snapshot, and programs that have the old file
+//      open (or memory-mapped by a sequence_view) keep reading the old
+//      one. If the snapshot can't be written, false is returned and
+//      file_name is unchanged.
+//
+//   const statistics& stats() const
+//    Pre:  none
+//    Post: The statistics of the items (see the statistics struct) are
+//      returned. They are computed in a single pass over the items,
+//      split among up to std::thread::hardware_concurrency() threads,
+//      and kept until the sequence next changes (insert, attach,
+//      remove_current, assignment, or a call of the non-constant
+//      items_begin, items_end or data); until then stats is O(1).
+//      While an iterator or data() pointer with write access may still
+//      be in use (one was returned by the non-constant items_begin,
+//      items_end or data since the last insert, attach, remove_current,
+//      insert_range, attach_range, resize, load, swap or assignment),
+//      the statistics are not kept: each call of stats computes them
+//      again, so a change made through such an iterator or pointer is
+//      always seen.
+//    Note: The items are summed in blocks of a few hundred with several
+//      independent running sums (which the compiler can vectorize), and
+//      the block sums are added with compensated (Kahan-Babuska)
+//      summation, so sum stays accurate for millions of items. Each
+//      block's variance is taken about the block's own mean (of the
+//      items minus the first item, so that large items close together
+//      lose no precision) and the blocks are combined with Chan et al.'s
+//      pairwise formula, which avoids the cancellation of the
+//      sum-of-squares method.
+//      stats updates the cached statistics, so it must not be called on
+//      one sequence by two threads at the same time. It is defined in
+//      SequenceStats.cpp (link SequenceStats.o, built with -pthread).
+//
 // VALUE SEMANTICS for the sequence class:
 //   Assignments and the copy constructor may be used with sequence
-//   objects.
+//   objects. Assignment takes its right-hand side by value (copy-and-
+//   swap): it copies from an lvalue, moves from an rvalue, and leaves
+//   the sequence unchanged if the copy fails. Temporaries are moved
+//   rather than copied (see the move constructor).
 
 #ifndef SEQUENCE_H
 #define SEQUENCE_H
-#include <cstdlib>  // provides size_t
+#include <cstddef>   // provides ptrdiff_t
+#include <cstdlib>   // provides size_t
+#include <iterator>  // provides random_access_iterator_tag
+#include <vector>    // provides vector
 
 namespace CS3358_FA2019
 {
@@ -103,27 +334,200 @@ namespace CS3358_FA2019
       typedef double value_type;
       typedef std::size_t size_type;
       static const size_type DEFAULT_CAPACITY = 30;
+      enum storage_mode { CONTIGUOUS, GAP_BUFFER };
+      struct statistics
+      {
+         size_type count;
+         value_type sum;
+         value_type min;
+         value_type max;
+         value_type mean;
+         value_type variance;
+      };
+      static const size_type STATS_MIN_PER_THREAD = 1 << 16;
+      template <class Value> class basic_iterator;
+      typedef basic_iterator<value_type> iterator;
+      typedef basic_iterator<const value_type> const_iterator;
+      typedef size_type bookmark;
       // CONSTRUCTORS and DESTRUCTOR
-      sequence(size_type initial_capacity = DEFAULT_CAPACITY);
+      sequence(size_type initial_capacity = DEFAULT_CAPACITY,
+               storage_mode mode = CONTIGUOUS);
       sequence(const sequence& source);
+      sequence(sequence&& source) noexcept;
       ~sequence();
       // MODIFICATION MEMBER FUNCTIONS
       void resize(size_type new_capacity);
       void start();
       void advance();
+      void end();
+      void move_back();
+      void seek(size_type index);
+      bookmark set_bookmark();
+      void go_to_bookmark(bookmark b);
+      void remove_bookmark(bookmark b);
       void insert(const value_type& entry);
       void attach(const value_type& entry);
+      void insert_range(const value_type* first, const value_type* last);
+      void attach_range(const value_type* first, const value_type* last);
       void remove_current();
-      sequence& operator=(const sequence& source);
+      sequence& operator=(sequence source) noexcept;
+      bool load(const char file_name[]);
+      void swap(sequence& other) noexcept;
+      iterator items_begin();
+      iterator items_end();
+      value_type* data();
       // CONSTANT MEMBER FUNCTIONS
       size_type size() const;
+      size_type position() const;
+      size_type bookmark_position(bookmark b) const;
+      storage_mode storage() const;
       bool is_item() const;
       value_type current() const;
+      const_iterator items_begin() const;
+      const_iterator items_end() const;
+      const value_type* data() const;
+      bool save(const char file_name[]) const;
+      const statistics& stats() const;
    private:
-      value_type* data;
+      value_type* buffer;
       size_type used;
       size_type current_index;
       size_type capacity;
+      mutable size_type gap_begin;
+      storage_mode mode;
+      mutable statistics cached_stats;
+      mutable bool stats_valid;
+      bool views_out;
+      std::vector<size_type> bookmarks;
+      // HELPER FUNCTIONS
+      size_type gap_start() const;
+      size_type physical(size_type i) const;
+      void move_gap(size_type position) const;
+      bool in_buffer(const value_type* p) const;
+      void make_room(size_type count);
+      void insert_at(size_type position, const value_type* first,
+                     const value_type* last);
+      void erase_at(size_type position);
+      bool is_bookmark(bookmark b) const;
+   };
+
+   // An iterator remembers where the gap was when it was made, and maps
+   // its position to an index of the dynamic array the same way
+   // physical() does (Value is value_type or const value_type)
+   template <class Value>
+   class sequence::basic_iterator
+   {
+   public:
+      typedef std::random_access_iterator_tag iterator_category;
+      typedef sequence::value_type value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef Value* pointer;
+      typedef Value& reference;
+
+      basic_iterator() : items(NULL), gap_begin(0), gap_size(0), index(0)
+      {
+      }
+      basic_iterator(Value* items, size_type gap_begin, size_type gap_size,
+                     difference_type index)
+      : items(items), gap_begin(gap_begin), gap_size(gap_size),
+        index(index)
+      {
+      }
+      // Copies an iterator, or converts one to a const_iterator
+      basic_iterator(const basic_iterator<sequence::value_type>& other)
+      : items(other.items), gap_begin(other.gap_begin),
+        gap_size(other.gap_size), index(other.index)
+      {
+      }
+
+      reference operator*() const
+      {
+         return items[size_type(index) < gap_begin ? index
+                                                   : index + gap_size];
+      }
+      pointer operator->() const { return &**this; }
+      reference operator[](difference_type n) const
+      {
+         return *(*this + n);
+      }
+
+      basic_iterator& operator++() { ++index; return *this; }
+      basic_iterator& operator--() { --index; return *this; }
+      basic_iterator operator++(int)
+      {
+         basic_iterator old(*this);
+         ++index;
+         return old;
+      }
+      basic_iterator operator--(int)
+      {
+         basic_iterator old(*this);
+         --index;
+         return old;
+      }
+      basic_iterator& operator+=(difference_type n)
+      {
+         index += n;
+         return *this;
+      }
+      basic_iterator& operator-=(difference_type n)
+      {
+         index -= n;
+         return *this;
+      }
+
+      friend basic_iterator operator+(basic_iterator it, difference_type n)
+      {
+         return it += n;
+      }
+      friend basic_iterator operator+(difference_type n, basic_iterator it)
+      {
+         return it += n;
+      }
+      friend basic_iterator operator-(basic_iterator it, difference_type n)
+      {
+         return it -= n;
+      }
+      friend difference_type operator-(const basic_iterator& a,
+                                       const basic_iterator& b)
+      {
+         return a.index - b.index;
+      }
+      friend bool operator==(const basic_iterator& a,
+                             const basic_iterator& b)
+      {
+         return a.index == b.index;
+      }
+      friend bool operator!=(const basic_iterator& a,
+                             const basic_iterator& b)
+      {
+         return a.index != b.index;
+      }
+      friend bool operator<(const basic_iterator& a, const basic_iterator& b)
+      {
+         return a.index < b.index;
+      }
+      friend bool operator>(const basic_iterator& a, const basic_iterator& b)
+      {
+         return a.index > b.index;
+      }
+      friend bool operator<=(const basic_iterator& a,
+                             const basic_iterator& b)
+      {
+         return a.index <= b.index;
+      }
+      friend bool operator>=(const basic_iterator& a,
+                             const basic_iterator& b)
+      {
+         return a.index >= b.index;
+      }
+
+   private:
+      template <class Other> friend class basic_iterator;
+      Value* items;
+      size_type gap_begin;
+      size_type gap_size;
+      difference_type index;
    };
 }
 
@@ -0,0 +1,388 @@
+// FILE: SequenceBench.cpp
+// A throughput benchmark for the sequence classes, written as CSV to cout
+// so that the results of different builds can be compared. It drives:
+//   contiguous  - sequence (Sequence.h) in CONTIGUOUS mode
+//   gap_buffer  - sequence in GAP_BUFFER mode
+//   chunked     - chunked_sequence (ChunkedSequence.h)
+//   a04         - sequence<double> of 4Assignment (../4Assignment/sequence.h)
+//
+// For each size n (MIN_SIZE, 10 * MIN_SIZE, ... up to max_size) each class
+// is run through two workloads, each giving one CSV row:
+//   fill  - n attaches to an empty sequence (ops = n)
+//   mixed - ops randomized operations on the filled sequence: 40% cursor
+//           moves (advance 1 to 8 items, starting over at the front when
+//           the cursor runs off the end, or 1 in 40 times start), 15%
+//           insert, 15% attach and 30% remove_current (so the size stays
+//           near n). insert and attach first call start if there is no
+//           current item, so every class ends with the same items. The
+//           operations are generated once per size from a fixed seed, so
+//           every class and every build gets the same ones.
+//
+// CSV columns:
+//   label           - the build label (see below)
+//   class, workload, size, ops
+//   ns_per_op       - the wall-clock time of the workload / ops
+//   allocations     - calls of operator new during the workload; for
+//                     sequence and sequence<T> each is a reallocation of
+//                     the dynamic array, for chunked_sequence a new node
+//   cache_misses    - the hardware cache-miss count (PERF_COUNT_HW_CACHE_
+//                     MISSES, usually last-level cache misses) and
+//   l1d_read_misses - the level 1 data cache read misses during the
+//                     workload, both counted with perf_event_open (Linux
+//                     only, user space only); empty where the counter
+//                     isn't available (other systems, virtual machines
+//                     without a PMU, or perf_event_paranoid > 2)
+//   checksum        - the sum of every current item read by the mixed
+//                     workload (fill: the size); equal for every class
+//                     and build, unless a sequence is wrong
+//
+// USAGE: a3bench [label [max_size [ops]]]
+//   label    defaults to the date and time the program was compiled
+//   max_size defaults to DEFAULT_MAX_SIZE
+//   ops      (for the mixed workload) defaults to DEFAULT_OPS
+
+#include <chrono>      // provides steady_clock
+#include <cstdio>      // provides printf
+#include <cstdlib>     // provides EXIT_SUCCESS, EXIT_FAILURE, atol, malloc
+#include <new>         // provides bad_alloc
+#include <random>      // provides mt19937
+#include <string>      // provides string
+#include <vector>      // provides vector
+#include "ChunkedSequence.h"
+#include "Sequence.h"
+#include "../4Assignment/sequence.h"
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+using namespace std;
+using CS3358_FA2019::sequence;
+using CS3358_FA2019::chunked_sequence;
+typedef CS3358_FA2019_A04_sequence::sequence<double> a04_sequence;
+
+const long MIN_SIZE = 100;
+const long DEFAULT_MAX_SIZE = 100000;
+const long DEFAULT_OPS = 20000;
+
+// The operations of the mixed workload
+enum op_kind { MOVE, START, INSERT, ATTACH, REMOVE };
+struct op
+{
+   op_kind kind;
+   int steps;       // MOVE: how many items to advance
+   double value;    // INSERT, ATTACH: the new item
+};
+
+// The results of one workload
+struct measurement
+{
+   double ns;
+   long allocations;
+   long long cache_misses;     // -1 if not counted
+   long long l1d_read_misses;  // -1 if not counted
+};
+
+// Counts calls of operator new (see the replacement below)
+long allocation_count = 0;
+
+// A hardware event counter for this process (user space only); it
+// counts nothing (read returns -1) if perf_event_open isn't available
+class event_counter
+{
+public:
+   event_counter(unsigned type, unsigned long long config);
+   ~event_counter();
+   void start();
+   long long stop();
+private:
+   int fd;
+};
+
+// PROTOTYPES for functions used by this benchmark program:
+
+vector<op> make_ops(long size, long ops);
+// Pre:  size >= 1, ops >= 0
+// Post: ops operations of the mixed workload (see the top of this file),
+//       generated from a seed that depends only on size, are returned.
+
+template <class Sequence>
+void insert_item(Sequence& s, double value);
+void insert_item(a04_sequence& s, double value);
+template <class Sequence>
+void attach_item(Sequence& s, double value);
+void attach_item(a04_sequence& s, double value);
+// Pre:  (none)
+// Post: value has been inserted before (insert_item) or after
+//       (attach_item) the current item of s, as sequence's insert and
+//       attach do (a04_sequence has no insert, and its add is attach).
+
+template <class Sequence>
+long long run_mixed(Sequence& s, const vector<op>& ops);
+// Pre:  (none)
+// Post: ops have been done on s; the checksum (see the top of this
+//       file) is returned.
+
+template <class Sequence>
+void bench_class(const char name[], const char label[], Sequence empty,
+                 long size, const vector<op>& ops);
+// Pre:  empty is an empty sequence.
+// Post: The fill and mixed workloads have been run on a copy of empty
+//       and their CSV rows written to cout.
+
+void print_row(const char label[], const char name[], const char workload[],
+               long size, long ops, const measurement& m,
+               long long checksum);
+// Pre:  ops >= 1
+// Post: One CSV row has been written to cout.
+
+#ifdef __linux__
+event_counter cache_misses(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+event_counter l1d_read_misses(PERF_TYPE_HW_CACHE,
+                              PERF_COUNT_HW_CACHE_L1D
+                              | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                              | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+#else
+event_counter cache_misses(0, 0);
+event_counter l1d_read_misses(0, 0);
+#endif
+
+int main(int argc, char* argv[])
+{
+   string label = (argc > 1) ? argv[1] : __DATE__ " " __TIME__;
+   long max_size = (argc > 2) ? atol(argv[2]) : DEFAULT_MAX_SIZE;
+   long ops = (argc > 3) ? atol(argv[3]) : DEFAULT_OPS;
+
+   if (max_size < MIN_SIZE || ops < 1)
+   {
+      fprintf(stderr, "usage: %s [label [max_size >= %ld [ops >= 1]]]\n",
+              argv[0], MIN_SIZE);
+      return EXIT_FAILURE;
+   }
+
+   printf("label,class,workload,size,ops,ns_per_op,allocations,"
+          "cache_misses,l1d_read_misses,checksum\n");
+   for (long size = MIN_SIZE; size <= max_size; size *= 10)
+   {
+      vector<op> mixed = make_ops(size, ops);
+      bench_class("contiguous", label.c_str(),
+                  sequence(sequence::DEFAULT_CAPACITY, sequence::CONTIGUOUS),
+                  size, mixed);
+      bench_class("gap_buffer", label.c_str(),
+                  sequence(sequence::DEFAULT_CAPACITY, sequence::GAP_BUFFER),
+                  size, mixed);
+      bench_class("chunked", label.c_str(), chunked_sequence(), size, mixed);
+      bench_class("a04", label.c_str(), a04_sequence(), size, mixed);
+   }
+   return EXIT_SUCCESS;
+}
+
+// Counting every allocation made through new (and so through
+// std::allocator)
+void* operator new(size_t bytes)
+{
+   ++allocation_count;
+   void* p = malloc(bytes == 0 ? 1 : bytes);
+   if (p == NULL)
+      throw bad_alloc();
+   return p;
+}
+
+void operator delete(void* p) noexcept
+{
+   free(p);
+}
+
+#ifdef __linux__
+event_counter::event_counter(unsigned type, unsigned long long config)
+{
+   perf_event_attr attr = perf_event_attr();
+   attr.size = sizeof(attr);
+   attr.type = type;
+   attr.config = config;
+   attr.disabled = 1;
+   attr.exclude_kernel = 1;
+   attr.exclude_hv = 1;
+   fd = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+event_counter::~event_counter()
+{
+   if (fd >= 0)
+      close(fd);
+}
+
+void event_counter::start()
+{
+   if (fd >= 0)
+   {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+   }
+}
+
+long long event_counter::stop()
+{
+   long long count;
+
+   if (fd < 0)
+      return -1;
+   ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+   if (read(fd, &count, sizeof(count)) != ssize_t(sizeof(count)))
+      return -1;
+   return count;
+}
+#else
+event_counter::event_counter(unsigned, unsigned long long) : fd(-1) { }
+event_counter::~event_counter() { }
+void event_counter::start() { }
+long long event_counter::stop() { return -1; }
+#endif
+
+vector<op> make_ops(long size, long ops)
+{
+   mt19937 generator(3358u + unsigned(size));
+   vector<op> result(ops);
+
+   for (long i = 0; i < ops; ++i)
+   {
+      unsigned roll = generator() % 200;
+      result[i].steps = 1 + int(generator() % 8);
+      result[i].value = double(generator() % 1000000);
+      if (roll < 2)
+         result[i].kind = START;
+      else if (roll < 80)
+         result[i].kind = MOVE;
+      else if (roll < 110)
+         result[i].kind = INSERT;
+      else if (roll < 140)
+         result[i].kind = ATTACH;
+      else
+         result[i].kind = REMOVE;
+   }
+   return result;
+}
+
+template <class Sequence>
+void insert_item(Sequence& s, double value)
+{
+   s.insert(value);
+}
+
+void insert_item(a04_sequence& s, double value)
+{
+   s.insert_range(&value, &value + 1);
+}
+
+template <class Sequence>
+void attach_item(Sequence& s, double value)
+{
+   s.attach(value);
+}
+
+void attach_item(a04_sequence& s, double value)
+{
+   s.add(value);
+}
+
+template <class Sequence>
+long long run_mixed(Sequence& s, const vector<op>& ops)
+{
+   long long checksum = 0;
+
+   for (size_t i = 0; i < ops.size(); ++i)
+   {
+      switch (ops[i].kind)
+      {
+      case START:
+         s.start();
+         break;
+      case MOVE:
+         for (int k = 0; k < ops[i].steps; ++k)
+         {
+            if (s.is_item())
+               s.advance();
+            else
+               s.start();
+         }
+         if (s.is_item())
+            checksum += (long long)(s.current());
+         break;
+      case INSERT:
+         if (!s.is_item())
+            s.start();
+         insert_item(s, ops[i].value);
+         break;
+      case ATTACH:
+         if (!s.is_item())
+            s.start();
+         attach_item(s, ops[i].value);
+         break;
+      case REMOVE:
+         if (s.is_item())
+            s.remove_current();
+         break;
+      }
+   }
+   return checksum;
+}
+
+template <class Sequence>
+void bench_class(const char name[], const char label[], Sequence empty,
+                 long size, const vector<op>& ops)
+{
+   Sequence s(empty);
+   measurement m;
+   long long checksum;
+   chrono::steady_clock::time_point t0, t1;
+
+   // fill
+   long allocations = allocation_count;
+   cache_misses.start();
+   l1d_read_misses.start();
+   t0 = chrono::steady_clock::now();
+   for (long i = 0; i < size; ++i)
+      attach_item(s, double(i));
+   t1 = chrono::steady_clock::now();
+   m.l1d_read_misses = l1d_read_misses.stop();
+   m.cache_misses = cache_misses.stop();
+   m.allocations = allocation_count - allocations;
+   m.ns = chrono::duration<double, nano>(t1 - t0).count();
+   print_row(label, name, "fill", size, size, m, (long long)(s.size()));
+
+   // mixed
+   allocations = allocation_count;
+   cache_misses.start();
+   l1d_read_misses.start();
+   t0 = chrono::steady_clock::now();
+   checksum = run_mixed(s, ops);
+   t1 = chrono::steady_clock::now();
+   m.l1d_read_misses = l1d_read_misses.stop();
+   m.cache_misses = cache_misses.stop();
+   m.allocations = allocation_count - allocations;
+   m.ns = chrono::duration<double, nano>(t1 - t0).count();
+   print_row(label, name, "mixed", size, long(ops.size()), m, checksum);
+}
+
+void print_row(const char label[], const char name[], const char workload[],
+               long size, long ops, const measurement& m,
+               long long checksum)
+{
+   // The label is quoted (with any quotes doubled) in case it has commas
+   putchar('"');
+   for (const char* c = label; *c != '\0'; ++c)
+   {
+      if (*c == '"')
+         putchar('"');
+      putchar(*c);
+   }
+   printf("\",%s,%s,%ld,%ld,%.2f,%ld,", name, workload, size, ops,
+          m.ns / ops, m.allocations);
+   if (m.cache_misses >= 0)
+      printf("%lld", m.cache_misses);
+   printf(",");
+   if (m.l1d_read_misses >= 0)
+      printf("%lld", m.l1d_read_misses);
+   printf(",%lld\n", checksum);
+}
@@ -0,0 +1,109 @@
+// FILE: SequenceCheck.h
+// The harness shared by the in-tree checks of sequence
+// (SequenceFileCheck.cpp, SequenceStatsCheck.cpp, SequenceCursorCheck.cpp
+// and SequenceIteratorCheck.cpp; part of the namespace CS3358_FA2019).
+// Each check writes a row per case to cout and exits with the status
+// returned by check_status:
+//   for (int m = 0; m < CHECK_MODE_COUNT; ++m)
+//   {
+//      sequence s = make_sequence(100, 50, CHECK_MODES[m], item);
+//      report("some case" + mode_suffix(m), s.size() == 100);
+//   }
+//   return check_status();
+//
+// CONSTANTS:
+//   const int CHECK_MODE_COUNT
+//   const sequence::storage_mode CHECK_MODES[CHECK_MODE_COUNT]
+//    The storage modes every check is run in (CONTIGUOUS and GAP_BUFFER).
+//
+// FUNCTIONS:
+//   std::string mode_suffix(int m)
+//    Pre:  0 <= m < CHECK_MODE_COUNT
+//    Post: The name of CHECK_MODES[m] in parentheses, preceded by a space
+//      (e.g. " (GAP_BUFFER)"), is returned.
+//
+//   bool report(const std::string& what, bool good)
+//    Pre:  none
+//    Post: A row naming the case what and saying "ok" or "FAIL" (as good
+//      is true or false) has been written to cout, a failure has been
+//      counted, and good is returned.
+//
+//   int check_status()
+//    Pre:  none
+//    Post: EXIT_SUCCESS is returned if no report so far was a failure,
+//      otherwise EXIT_FAILURE.
+//
+//   sequence make_sequence(sequence::size_type n, sequence::size_type gap,
+//                          sequence::storage_mode mode,
+//                          sequence::value_type (*item)(sequence::size_type))
+//    Pre:  gap < n
+//    Post: A sequence of the given mode holding item(0), item(1), ...,
+//      item(n - 1), in order, is returned; it has no current item. The
+//      item at position gap was inserted last, so the gap of a
+//      GAP_BUFFER sequence is left there.
+
+#ifndef SEQUENCE_CHECK_H
+#define SEQUENCE_CHECK_H
+#include <cstdlib>   // provides EXIT_SUCCESS, EXIT_FAILURE
+#include <iomanip>   // provides setw, left
+#include <iostream>  // provides cout
+#include <string>    // provides string
+#include "Sequence.h"
+
+namespace CS3358_FA2019
+{
+   const int CHECK_MODE_COUNT = 2;
+   const sequence::storage_mode CHECK_MODES[CHECK_MODE_COUNT] =
+      { sequence::CONTIGUOUS, sequence::GAP_BUFFER };
+
+   inline std::string mode_suffix(int m)
+   {
+      const char* NAMES[CHECK_MODE_COUNT] = { "CONTIGUOUS", "GAP_BUFFER" };
+      return std::string(" (") + NAMES[m] + ")";
+   }
+
+   // The number of failed reports (one counter for the whole program)
+   inline int& check_failures()
+   {
+      static int failures = 0;
+      return failures;
+   }
+
+   inline bool report(const std::string& what, bool good)
+   {
+      std::cout << std::setw(56) << std::left << what
+                << (good ? "ok" : "FAIL") << std::endl;
+      if (!good)
+      {
+         ++check_failures();
+      }
+      return good;
+   }
+
+   inline int check_status()
+   {
+      return (check_failures() == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+   }
+
+   inline sequence make_sequence(sequence::size_type n,
+                                 sequence::size_type gap,
+                                 sequence::storage_mode mode,
+                                 sequence::value_type
+                                    (*item)(sequence::size_type))
+   {
+      sequence s(n, mode);
+      for (sequence::size_type i = 0; i < n; ++i)
+      {
+         if (i != gap)
+         {
+            s.attach(item(i));
+         }
+      }
+      s.seek(gap);
+      s.insert(item(gap));
+      s.seek(n);
+      return s;
+   }
+}
+
+#endif
@@ -0,0 +1,137 @@
+// FILE: SequenceCursorCheck.cpp
+//       A check of the bidirectional cursor and the bookmarks of
+//       sequence, in both storage modes:
+//       - end, move_back and seek put the cursor on the right item (or
+//         on no item), and move_back walks the items from last to first;
+//       - a bookmark stays on its item while items are inserted,
+//         attached and removed before it, at it and after it; if its
+//         item is removed it moves to the next item, and a bookmark past
+//         the last item stays there;
+//       - go_to_bookmark makes its item current, remove_bookmark frees
+//         its number for reuse, and copies of a sequence copy its
+//         bookmarks.
+//       A line is written to cout for each check (see SequenceCheck.h),
+//       and the program exits with EXIT_FAILURE if any of them failed.
+
+#include <string>
+#include "Sequence.h"
+#include "SequenceCheck.h"
+using namespace std;
+using namespace CS3358_FA2019;
+
+// Returns the item at position i of the checked sequences: i itself
+double item(sequence::size_type i)
+{
+   return double(i);
+}
+
+// Returns true if bookmark b of s is at position and (unless it is past
+// the last item) on the item value; s's cursor is left where it was
+bool on_item(sequence& s, sequence::bookmark b, sequence::size_type position,
+             double value)
+{
+   sequence::size_type cursor = s.position();
+   bool good = s.bookmark_position(b) == position;
+   s.go_to_bookmark(b);
+   good = good && s.position() == position
+          && (position == s.size() ? !s.is_item() : s.current() == value);
+   s.seek(cursor);
+   return good;
+}
+
+int main()
+{
+   for (int m = 0; m < CHECK_MODE_COUNT; ++m)
+   {
+      string mode = mode_suffix(m);
+      sequence s = make_sequence(20, 10, CHECK_MODES[m], item);
+
+      // end, move_back and seek
+      s.end();
+      bool good = s.is_item() && s.position() == 19 && s.current() == 19;
+      for (int i = 18; i >= 0; --i)
+      {
+         s.move_back();
+         good = good && s.is_item() && s.current() == i;
+      }
+      s.move_back();
+      good = good && !s.is_item() && s.position() == s.size();
+      report("end and move_back" + mode, good);
+      s.seek(7);
+      good = s.is_item() && s.current() == 7;
+      s.seek(20);
+      good = good && !s.is_item();
+      sequence none(1, CHECK_MODES[m]);
+      none.end();
+      good = good && !none.is_item();
+      report("seek, and end of an empty sequence" + mode, good);
+
+      // A bookmark on item 10, and one past the last item
+      s.seek(10);
+      sequence::bookmark b = s.set_bookmark();
+      s.seek(20);
+      sequence::bookmark past = s.set_bookmark();
+      report("set_bookmark" + mode,
+             b != past && on_item(s, b, 10, 10)
+             && on_item(s, past, 20, 0));
+
+      s.seek(3);
+      s.insert(-1);
+      report("insert before a bookmark" + mode,
+             on_item(s, b, 11, 10) && on_item(s, past, 21, 0));
+      s.seek(5);
+      s.attach(-2);
+      report("attach before a bookmark" + mode,
+             on_item(s, b, 12, 10) && on_item(s, past, 22, 0));
+      s.go_to_bookmark(b);
+      s.insert(-3);
+      report("insert at a bookmark" + mode,
+             on_item(s, b, 13, 10) && s.current() == -3);
+      s.go_to_bookmark(b);
+      s.attach(-4);
+      report("attach at a bookmark" + mode,
+             on_item(s, b, 13, 10) && s.position() == 14);
+      s.seek(17);
+      s.insert(-5);
+      s.end();
+      s.attach(-6);
+      report("insert and attach after a bookmark" + mode,
+             on_item(s, b, 13, 10) && on_item(s, past, 26, 0));
+      s.seek(26);
+      s.attach(-7);
+      report("attach at a bookmark past the last item" + mode,
+             on_item(s, past, 27, 0) && s.position() == 26);
+
+      s.seek(0);
+      s.remove_current();
+      report("remove before a bookmark" + mode,
+             on_item(s, b, 12, 10) && on_item(s, past, 26, 0));
+      s.seek(14);
+      s.remove_current();
+      report("remove after a bookmark" + mode,
+             on_item(s, b, 12, 10) && on_item(s, past, 25, 0));
+      s.go_to_bookmark(b);
+      s.remove_current();
+      report("remove at a bookmark" + mode,
+             on_item(s, b, 12, -4) && on_item(s, past, 24, 0));
+      s.end();
+      s.remove_current();
+      report("remove the last item" + mode,
+             on_item(s, past, 23, 0) && !s.is_item());
+
+      // Copies, removal and reuse of bookmark numbers
+      sequence copy(s);
+      copy.seek(0);
+      copy.insert(-8);
+      report("a copy keeps the bookmarks" + mode,
+             on_item(copy, b, 13, -4) && on_item(s, b, 12, -4));
+      s.remove_bookmark(b);
+      s.seek(1);
+      sequence::bookmark again = s.set_bookmark();
+      report("remove_bookmark and reuse" + mode,
+             again == b && on_item(s, again, 1, 2)
+             && on_item(s, past, 23, 0));
+   }
+
+   return check_status();
+}
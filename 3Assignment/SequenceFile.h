@@ -0,0 +1,99 @@
+// FILE: SequenceFile.h
+// The binary snapshot format written by sequence::save and read by
+// sequence::load and sequence_view::open (part of the namespace
+// CS3358_FA2019). A snapshot file is a 32-byte header followed by the
+// items:
+//   bytes 0-7    magic          the characters "CS3358SQ"
+//   bytes 8-9    version        SEQUENCE_FILE_VERSION
+//   bytes 10-11  item_size      sizeof(sequence::value_type)
+//   bytes 12-15  byte_order     SEQUENCE_FILE_BYTE_ORDER
+//   bytes 16-23  count          the number of items
+//   bytes 24-31  current_index  the position of the current item (count
+//                               if there is no current item)
+//   bytes 32-    the count items, in order, as raw value_type
+// The numbers are stored as the saving machine stores them; a file saved
+// by a machine with another byte order or item size fails check_header
+// rather than being converted. The items start 32 bytes into the file,
+// so they are properly aligned when the file is memory-mapped.
+//
+// TYPES and CONSTANTS:
+//   struct sequence_file_header
+//    The header, laid out as above.
+//
+//   const std::uint16_t SEQUENCE_FILE_VERSION
+//   const std::uint32_t SEQUENCE_FILE_BYTE_ORDER
+//    The version written, and a number whose bytes differ in every
+//    position (so it reads back unchanged only with the same byte order).
+//
+// FUNCTIONS:
+//   void fill_header(sequence_file_header& header, std::uint64_t count,
+//                    std::uint64_t current_index)
+//    Pre:  current_index <= count
+//    Post: header is the header of a snapshot of count items with the
+//      given current_index.
+//
+//   bool check_header(const sequence_file_header& header,
+//                     std::uint64_t file_size)
+//    Pre:  none
+//    Post: true is returned if header is a header of this version written
+//      on a machine like this one, current_index <= count, and file_size
+//      is exactly the size of the header plus count items; otherwise
+//      false is returned.
+
+#ifndef SEQUENCE_FILE_H
+#define SEQUENCE_FILE_H
+#include <cstdint>  // provides uint16_t, uint32_t, uint64_t
+#include <cstring>  // provides memcpy, memcmp
+#include "Sequence.h"
+
+namespace CS3358_FA2019
+{
+   struct sequence_file_header
+   {
+      char magic[8];
+      std::uint16_t version;
+      std::uint16_t item_size;
+      std::uint32_t byte_order;
+      std::uint64_t count;
+      std::uint64_t current_index;
+   };
+   static_assert(sizeof(sequence_file_header) == 32,
+                 "the snapshot header must be 32 bytes");
+
+   const std::uint16_t SEQUENCE_FILE_VERSION = 1;
+   const std::uint32_t SEQUENCE_FILE_BYTE_ORDER = 0x01020304;
+
+   inline void fill_header(sequence_file_header& header,
+                           std::uint64_t count, std::uint64_t current_index)
+   {
+      std::memcpy(header.magic, "CS3358SQ", sizeof(header.magic));
+      header.version = SEQUENCE_FILE_VERSION;
+      header.item_size = sizeof(sequence::value_type);
+      header.byte_order = SEQUENCE_FILE_BYTE_ORDER;
+      header.count = count;
+      header.current_index = current_index;
+   }
+
+   inline bool check_header(const sequence_file_header& header,
+                            std::uint64_t file_size)
+   {
+      const std::uint64_t item_size = sizeof(sequence::value_type);
+
+      if (std::memcmp(header.magic, "CS3358SQ", sizeof(header.magic)) != 0
+          || header.version != SEQUENCE_FILE_VERSION
+          || header.item_size != item_size
+          || header.byte_order != SEQUENCE_FILE_BYTE_ORDER
+          || header.current_index > header.count)
+      {
+         return false;
+      }
+
+      // Comparing the item counts (rather than multiplying) so that a
+      // huge count can't overflow
+      return file_size >= sizeof(header)
+             && (file_size - sizeof(header)) % item_size == 0
+             && (file_size - sizeof(header)) / item_size == header.count;
+   }
+}
+
+#endif
@@ -0,0 +1,156 @@
+// FILE: SequenceFileCheck.cpp
+//       A check of the binary snapshots of sequence (see SequenceFile.h):
+//       - a sequence saved with save and read back with load has the
+//         same items and current item, in both storage modes (with the
+//         gap of a GAP_BUFFER sequence in the middle when it is saved),
+//         and with or without a current item;
+//       - a sequence_view opened on the saved file shows the same items
+//         and current item;
+//       - load returns false, and leaves the sequence (items, current
+//         item and bookmarks) unchanged, for a truncated snapshot, one
+//         with a bad header and a file that doesn't exist.
+//       A line is written to cout for each check (see SequenceCheck.h),
+//       and the program exits with EXIT_FAILURE if any of them failed.
+//       The snapshot files are written to (and removed from) the current
+//       directory.
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Sequence.h"
+#include "SequenceCheck.h"
+#include "SequenceFile.h"
+#include "SequenceView.h"
+using namespace std;
+using namespace CS3358_FA2019;
+
+const char SNAPSHOT[] = "a3file_check.seq";
+const char DAMAGED[] = "a3file_damaged.seq";
+const char MISSING[] = "a3file_no_such_file.seq";
+
+// Returns the items of s, in order
+vector<double> items_of(const sequence& s)
+{
+   return vector<double>(s.items_begin(), s.items_end());
+}
+
+// Returns the item at position i of the saved sequences: i + 0.5
+double item(sequence::size_type i)
+{
+   return i + 0.5;
+}
+
+// Copies the first keep bytes of file from to file to
+void copy_prefix(const char from[], const char to[], streamsize keep)
+{
+   ifstream in(from, ios::binary);
+   vector<char> bytes(keep);
+   in.read(bytes.data(), keep);
+   ofstream out(to, ios::binary | ios::trunc);
+   out.write(bytes.data(), in.gcount());
+}
+
+// Overwrites the byte at offset of file with value
+void poke(const char file[], streamoff offset, char value)
+{
+   fstream io(file, ios::binary | ios::in | ios::out);
+   io.seekp(offset);
+   io.put(value);
+}
+
+// Tries to load file_name into s, and returns true if load failed and
+// left s's items, current item and bookmark b as they were
+bool load_fails(sequence& s, const char file_name[], sequence::bookmark b)
+{
+   vector<double> before = items_of(s);
+   sequence::size_type position = s.position();
+   sequence::size_type marked = s.bookmark_position(b);
+   bool loaded = s.load(file_name);
+   return !loaded && items_of(s) == before && s.position() == position
+          && s.bookmark_position(b) == marked;
+}
+
+int main()
+{
+   for (int m = 0; m < CHECK_MODE_COUNT; ++m)
+   {
+      string mode = mode_suffix(m);
+
+      // Round trips of an empty sequence, one with its cursor in the
+      // middle and one with no current item
+      sequence empty(1, CHECK_MODES[m]);
+      sequence loaded(1, CHECK_MODES[m]);
+      loaded.attach(99.0);
+      report("empty round trip" + mode,
+             empty.save(SNAPSHOT) && loaded.load(SNAPSHOT)
+             && loaded.size() == 0 && !loaded.is_item()
+             && loaded.storage() == CHECK_MODES[m]);
+
+      sequence s = make_sequence(1000, 500, CHECK_MODES[m], item);
+      s.seek(321);
+      report("round trip, cursor at 321" + mode,
+             s.save(SNAPSHOT) && loaded.load(SNAPSHOT)
+             && items_of(loaded) == items_of(s)
+             && loaded.position() == 321
+             && loaded.current() == 321.5
+             && loaded.storage() == CHECK_MODES[m]);
+
+      // Edits after a load work on the loaded items
+      loaded.insert(-1.0);
+      loaded.end();
+      loaded.attach(-2.0);
+      report("edits after load" + mode,
+             loaded.size() == 1002
+             && loaded.items_begin()[321] == -1.0
+             && loaded.items_begin()[322] == 321.5
+             && loaded.items_begin()[1001] == -2.0);
+
+      s.seek(s.size());
+      report("round trip, no current item" + mode,
+             s.save(SNAPSHOT) && loaded.load(SNAPSHOT)
+             && items_of(loaded) == items_of(s)
+             && !loaded.is_item());
+
+      // A view over the saved file
+      s.seek(7);
+      sequence_view view;
+      bool opened = s.save(SNAPSHOT) && view.open(SNAPSHOT);
+      report("view of the snapshot" + mode,
+             opened && view.is_open() && view.size() == s.size()
+             && vector<double>(view.items_begin(),
+                               view.items_end()) == items_of(s)
+             && view.is_item() && view.current() == 7.5);
+      view.close();
+
+      // Failed loads: the sequence keeps its items, cursor and bookmark
+      s.seek(500);
+      sequence::bookmark b = s.set_bookmark();
+      s.seek(12);
+      s.save(SNAPSHOT);
+      copy_prefix(SNAPSHOT, DAMAGED, 32 + 999 * sizeof(double));
+      report("load rejects a truncated snapshot" + mode,
+             load_fails(s, DAMAGED, b));
+      copy_prefix(SNAPSHOT, DAMAGED, 20);
+      report("load rejects a truncated header" + mode,
+             load_fails(s, DAMAGED, b));
+      copy_prefix(SNAPSHOT, DAMAGED, 32 + 1000 * sizeof(double));
+      poke(DAMAGED, 0, 'X');
+      report("load rejects a bad magic" + mode, load_fails(s, DAMAGED, b));
+      copy_prefix(SNAPSHOT, DAMAGED, 32 + 1000 * sizeof(double));
+      poke(DAMAGED, 8, char(SEQUENCE_FILE_VERSION + 1));
+      report("load rejects a bad version" + mode, load_fails(s, DAMAGED, b));
+      copy_prefix(SNAPSHOT, DAMAGED, 32 + 1000 * sizeof(double));
+      poke(DAMAGED, 31, char(0x7f));
+      report("load rejects a bad current_index" + mode,
+             load_fails(s, DAMAGED, b));
+      remove(MISSING);
+      report("load rejects a missing file" + mode, load_fails(s, MISSING, b));
+      report("view rejects a bad snapshot" + mode,
+             !view.open(DAMAGED) && !view.is_open());
+   }
+
+   remove(SNAPSHOT);
+   remove(DAMAGED);
+   return check_status();
+}
@@ -0,0 +1,96 @@
+// FILE: SequenceIteratorCheck.cpp
+//       A check of the random-access iterators and data() of sequence,
+//       in both storage modes, with the gap of a GAP_BUFFER sequence in
+//       the middle of the items:
+//       - std::accumulate over [items_begin(), items_end()) (and over
+//         the const iterators) adds up every item once;
+//       - the constant data() alone (through a const reference) closes
+//         the gap and returns the items in order;
+//       - std::sort over [items_begin(), items_end()) sorts the items,
+//         and the iterators' arithmetic, comparisons and indexing agree
+//         with the positions of the items;
+//       - the non-constant data() returns the items in order (closing
+//         the gap), data()[position()] is current(), a write through it
+//         is seen by current(), and the constant data() then returns
+//         the same pointer.
+//       A line is written to cout for each check (see SequenceCheck.h),
+//       and the program exits with EXIT_FAILURE if any of them failed.
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include "Sequence.h"
+#include "SequenceCheck.h"
+using namespace std;
+using namespace CS3358_FA2019;
+
+const sequence::size_type N = 1001;
+
+// Returns the item at position i of the checked sequences: 0 .. N-1 in
+// a scrambled order
+double item(sequence::size_type i)
+{
+   return double((i * 7919) % N);
+}
+
+int main()
+{
+   const double SUM = double(N) * (N - 1) / 2;
+
+   for (int m = 0; m < CHECK_MODE_COUNT; ++m)
+   {
+      string mode = mode_suffix(m);
+      sequence s = make_sequence(N, N / 2, CHECK_MODES[m], item);
+      const sequence& cs = s;
+
+      report("accumulate over the const iterators" + mode,
+             accumulate(cs.items_begin(), cs.items_end(), 0.0) == SUM
+             && cs.items_end() - cs.items_begin()
+                == sequence::const_iterator::difference_type(N));
+      report("accumulate over the iterators" + mode,
+             accumulate(s.items_begin(), s.items_end(), 0.0) == SUM);
+
+      // The constant data(), with the gap still in the middle
+      const double* citems = cs.data();
+      bool good = accumulate(citems, citems + N, 0.0) == SUM;
+      for (sequence::size_type i = 0; i < N; ++i)
+      {
+         good = good && citems[i] == item(i) && cs.items_begin()[i] == item(i);
+      }
+      report("const data() with the gap in the middle" + mode, good);
+
+      // Sorting in place, then checking the items against 0 .. N-1
+      sort(s.items_begin(), s.items_end());
+      sequence::iterator first = s.items_begin();
+      sequence::const_iterator last = s.items_end();
+      good = true;
+      for (sequence::size_type i = 0; i < N; ++i)
+      {
+         s.seek(i);
+         good = good && first[i] == double(i) && s.current() == double(i)
+                && *(first + i) == double(i) && first + i < last;
+      }
+      good = good && first + N == last && last - N == first
+             && is_sorted(cs.items_begin(), cs.items_end());
+      report("sort over the iterators" + mode, good);
+
+      // data() against current(), with the cursor in the middle
+      s.seek(N / 3);
+      s.insert(-1.0);
+      s.seek(N / 2);
+      double* items = s.data();
+      good = items[s.position()] == s.current();
+      for (sequence::size_type i = 0; i < s.size(); ++i)
+      {
+         good = good && items[i] == s.items_begin()[i];
+      }
+      report("data() against current()" + mode, good);
+      items[s.position()] = 1e6;
+      report("write through data()" + mode,
+             s.current() == 1e6 && cs.data() == items
+             && accumulate(cs.items_begin(), cs.items_end(), 0.0)
+                == SUM - 1.0 - double(N / 2 - 1) + 1e6);
+   }
+
+   return check_status();
+}
@@ -0,0 +1,332 @@
+// FILE: SequenceStats.cpp
+// FUNCTION IMPLEMENTED: sequence::stats (see Sequence.h for documentation)
+// (kept apart from Sequence.cpp so that only programs calling stats need
+// to be built with -pthread)
+//
+// The positions 0 .. used-1 are split into parts of about the same
+// size, at least STATS_MIN_PER_THREAD each and at most one per hardware
+// thread. Each part is summarized by its own thread (the calling thread
+// takes the first part), and the summaries are then merged in order, so
+// the result does not depend on how the threads are scheduled. A part
+// that straddles the gap (invariant 2 in Sequence.cpp) is summarized as
+// the two runs of buffer on either side of it.
+//
+// A run is summarized BLOCK_SIZE items at a time. A block is read twice
+// while it is in the cache: once for its sum, min and max (LANES
+// independent running values, so the loop vectorizes), and once for the
+// squared differences from the block's own mean. Block summaries are
+// merged into the run's as described for merge below.
+//
+// Means are taken of the items minus a shift (the first item of the
+// sequence), which leaves the variance unchanged. Without it, the
+// means of items that are large but close together (1e9 +- 1, say)
+// are rounded to about 1e-7, and merge turns that into relative errors
+// of 1e-9 in the variance; with it the means are near 0 and keep their
+// precision. sum is accumulated from the items themselves.
+//
+// DOCUMENTATION for the helper functions (file scope):
+//   struct summary
+//    The statistics of some items in the form that can be merged: count,
+//    sum + correction (a compensated sum), min, max, mean (of the items
+//    minus the shift) and m2 (the sum of the squared differences from
+//    their mean). A summary with count 0 stands for no items; its other
+//    members are ignored.
+//
+//   void add_compensated(value_type& sum, value_type& correction,
+//                        value_type x)
+//    Pre:  none
+//    Post: x has been added to sum + correction, with the rounding error
+//      of sum + x kept in correction (Neumaier's form of Kahan
+//      summation, which also handles x larger than sum).
+//
+//   void merge(summary& into, const summary& part)
+//    Pre:  none
+//    Post: into summarizes its own items followed by part's. The means
+//      and m2s are combined with the formula of Chan, Golub and LeVeque:
+//        delta = part.mean - into.mean
+//        mean  = into.mean + delta * part.count / n
+//        m2    = into.m2 + part.m2 + delta^2 * into.count * part.count / n
+//      (n the total count).
+//
+//   summary summarize_block(const value_type* first, size_type count,
+//                           value_type shift)
+//    Pre:  1 <= count <= BLOCK_SIZE; [first, first + count) are items.
+//    Post: The summary of the items is returned.
+//
+//   void summarize_run(const value_type* first, size_type count,
+//                      value_type shift, summary& result)
+//    Pre:  [first, first + count) are items.
+//    Post: The items have been merged into result, a block at a time.
+//
+//   struct part
+//    One part of the positions, as at most two runs of buffer, the
+//    shift, and the part's summary once summarize_part has run.
+//
+//   void summarize_part(part* work)
+//    Pre:  work->result has count 0.
+//    Post: work->result is the summary of work's runs, in order.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "Sequence.h"
+#include <system_error>
+#include <thread>
+#include <vector>
+using namespace std;
+
+namespace
+{
+   typedef CS3358_FA2019::sequence::value_type value_type;
+   typedef CS3358_FA2019::sequence::size_type size_type;
+
+   const size_type BLOCK_SIZE = 512;
+   const size_type LANES = 8;
+
+   struct summary
+   {
+      size_type count;
+      value_type sum;
+      value_type correction;
+      value_type min;
+      value_type max;
+      value_type mean;
+      value_type m2;
+   };
+
+   struct part
+   {
+      const value_type* first[2];
+      size_type count[2];
+      value_type shift;
+      summary result;
+   };
+
+   void add_compensated(value_type& sum, value_type& correction,
+                        value_type x)
+   {
+      value_type total = sum + x;
+
+      // Whichever of sum and x is smaller lost the low bits
+      if (fabs(sum) >= fabs(x))
+      {
+         correction += (sum - total) + x;
+      }
+      else
+      {
+         correction += (x - total) + sum;
+      }
+      sum = total;
+   }
+
+   void merge(summary& into, const summary& part)
+   {
+      if (part.count == 0)
+      {
+         return;
+      }
+      if (into.count == 0)
+      {
+         into = part;
+         return;
+      }
+
+      value_type n = value_type(into.count) + value_type(part.count);
+      value_type delta = part.mean - into.mean;
+      into.mean += delta * (value_type(part.count) / n);
+      into.m2 += part.m2
+                 + delta * delta * (value_type(into.count)
+                                    * value_type(part.count) / n);
+      add_compensated(into.sum, into.correction, part.sum);
+      into.correction += part.correction;
+      into.min = min(into.min, part.min);
+      into.max = max(into.max, part.max);
+      into.count += part.count;
+   }
+
+   summary summarize_block(const value_type* first, size_type count,
+                           value_type shift)
+   {
+      value_type sums[LANES], shifted[LANES], lows[LANES], highs[LANES];
+      size_type i, k;
+
+      for (k = 0; k < LANES; ++k)
+      {
+         sums[k] = shifted[k] = 0;
+         lows[k] = highs[k] = first[0];
+      }
+
+      // First pass: LANES running sums, shifted sums, mins and maxes
+      for (i = 0; i + LANES <= count; i += LANES)
+      {
+         for (k = 0; k < LANES; ++k)
+         {
+            value_type x = first[i + k];
+            sums[k] += x;
+            shifted[k] += x - shift;
+            lows[k] = (x < lows[k]) ? x : lows[k];
+            highs[k] = (x > highs[k]) ? x : highs[k];
+         }
+      }
+      for (k = 0; i < count; ++i, ++k)
+      {
+         sums[k] += first[i];
+         shifted[k] += first[i] - shift;
+         lows[k] = min(lows[k], first[i]);
+         highs[k] = max(highs[k], first[i]);
+      }
+
+      // Adding the lanes pairwise
+      for (size_type width = LANES / 2; width > 0; width /= 2)
+      {
+         for (k = 0; k < width; ++k)
+         {
+            sums[k] += sums[k + width];
+            shifted[k] += shifted[k + width];
+            lows[k] = min(lows[k], lows[k + width]);
+            highs[k] = max(highs[k], highs[k + width]);
+         }
+      }
+
+      summary result;
+      result.count = count;
+      result.sum = sums[0];
+      result.correction = 0;
+      result.min = lows[0];
+      result.max = highs[0];
+      result.mean = shifted[0] / value_type(count);
+
+      // Second pass: squared differences from the block's mean
+      value_type squares[LANES];
+      for (k = 0; k < LANES; ++k)
+      {
+         squares[k] = 0;
+      }
+      for (i = 0; i + LANES <= count; i += LANES)
+      {
+         for (k = 0; k < LANES; ++k)
+         {
+            value_type d = (first[i + k] - shift) - result.mean;
+            squares[k] += d * d;
+         }
+      }
+      for (k = 0; i < count; ++i, ++k)
+      {
+         value_type d = (first[i] - shift) - result.mean;
+         squares[k] += d * d;
+      }
+      for (size_type width = LANES / 2; width > 0; width /= 2)
+      {
+         for (k = 0; k < width; ++k)
+         {
+            squares[k] += squares[k + width];
+         }
+      }
+      result.m2 = squares[0];
+      return result;
+   }
+
+   void summarize_run(const value_type* first, size_type count,
+                      value_type shift, summary& result)
+   {
+      for (size_type i = 0; i < count; i += BLOCK_SIZE)
+      {
+         merge(result, summarize_block(first + i,
+                                       min(BLOCK_SIZE, count - i), shift));
+      }
+   }
+
+   void summarize_part(part* work)
+   {
+      summarize_run(work->first[0], work->count[0], work->shift,
+                    work->result);
+      summarize_run(work->first[1], work->count[1], work->shift,
+                    work->result);
+   }
+}
+
+namespace CS3358_FA2019
+{
+   const sequence::statistics& sequence::stats() const
+   {
+      if (stats_valid)
+      {
+         return cached_stats;
+      }
+
+      cached_stats.count = used;
+      if (used == 0)
+      {
+         cached_stats.sum = 0;
+         cached_stats.min = cached_stats.max = cached_stats.mean
+            = cached_stats.variance = numeric_limits<value_type>::quiet_NaN();
+         stats_valid = !views_out;
+         return cached_stats;
+      }
+
+      // Choosing the number of parts (one per thread)
+      size_type parts = used / STATS_MIN_PER_THREAD;
+      size_type threads = thread::hardware_concurrency();
+      parts = min(parts, max(threads, size_type(1)));
+      parts = max(parts, size_type(1));
+
+      // Mapping each part's positions to the runs of buffer before and
+      // after the gap
+      size_type front = gap_start();
+      size_type gap_size = capacity - used;
+      size_type part_size = used / parts;
+      value_type shift = buffer[physical(0)];
+      vector<part> work(parts);
+      for (size_type p = 0; p < parts; ++p)
+      {
+         size_type low = p * part_size;
+         size_type high = (p + 1 == parts) ? used : low + part_size;
+         size_type after = max(low, front);
+
+         work[p].first[0] = buffer + low;
+         work[p].count[0] = (low < front) ? min(high, front) - low : 0;
+         work[p].first[1] = buffer + after + gap_size;
+         work[p].count[1] = (high > after) ? high - after : 0;
+         work[p].shift = shift;
+         work[p].result.count = 0;
+      }
+
+      // Summarizing the parts; a part whose thread can't be started is
+      // summarized here instead
+      vector<thread> workers;
+      workers.reserve(parts - 1);
+      for (size_type p = 1; p < parts; ++p)
+      {
+         try
+         {
+            workers.push_back(thread(summarize_part, &work[p]));
+         }
+         catch (const system_error&)
+         {
+            summarize_part(&work[p]);
+         }
+      }
+      summarize_part(&work[0]);
+      for (size_type t = 0; t < workers.size(); ++t)
+      {
+         workers[t].join();
+      }
+
+      summary total = work[0].result;
+      for (size_type p = 1; p < parts; ++p)
+      {
+         merge(total, work[p].result);
+      }
+
+      cached_stats.sum = total.sum + total.correction;
+      cached_stats.min = total.min;
+      cached_stats.max = total.max;
+      cached_stats.mean = cached_stats.sum / value_type(used);
+      cached_stats.variance = total.m2 / value_type(used);
+
+      // Keeping the statistics only if no write access is handed out
+      // (invariant 6 in Sequence.cpp)
+      stats_valid = !views_out;
+      return cached_stats;
+   }
+}
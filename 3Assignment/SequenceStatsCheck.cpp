@@ -0,0 +1,155 @@
+// FILE: SequenceStatsCheck.cpp
+//       A check of sequence::stats against a naive loop over the items
+//       (a sum, a min/max scan and a second pass for the variance):
+//       - an empty sequence has count and sum 0, and NaN min, max, mean
+//         and variance;
+//       - GAP_BUFFER sequences long enough to be split among several
+//         threads, with the gap at the front, in the middle, at a part
+//         boundary and at the end, give the same statistics as
+//         CONTIGUOUS ones;
+//       - the statistics follow every kind of change: insert, attach,
+//         insert_range and attach_range (insert_at), remove_current
+//         (erase_at), and writes through the non-constant data() and
+//         items_begin(), including writes made after stats has been
+//         called while the pointer or iterator was still out.
+//       A line is written to cout for each check (see SequenceCheck.h),
+//       and the program exits with EXIT_FAILURE if any of them failed.
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include "Sequence.h"
+#include "SequenceCheck.h"
+using namespace std;
+using namespace CS3358_FA2019;
+
+// Returns true if a and b agree to about 1e-9 of their size (or are
+// both NaN)
+bool close_to(double a, double b)
+{
+   if (std::isnan(a) || std::isnan(b))
+   {
+      return std::isnan(a) && std::isnan(b);
+   }
+   return fabs(a - b) <= 1e-9 * max(1.0, max(fabs(a), fabs(b)));
+}
+
+// Returns true if s.stats() matches the statistics of s's items
+// computed by a naive loop
+bool matches_naive(const sequence& s)
+{
+   const sequence::statistics& got = s.stats();
+   vector<double> items(s.items_begin(), s.items_end());
+   double sum = 0, smallest = NAN, largest = NAN;
+   double mean = NAN, variance = NAN;
+
+   if (!items.empty())
+   {
+      smallest = largest = items[0];
+      for (size_t i = 0; i < items.size(); ++i)
+      {
+         sum += items[i];
+         smallest = (items[i] < smallest) ? items[i] : smallest;
+         largest = (items[i] > largest) ? items[i] : largest;
+      }
+      mean = sum / items.size();
+      variance = 0;
+      for (size_t i = 0; i < items.size(); ++i)
+      {
+         variance += (items[i] - mean) * (items[i] - mean);
+      }
+      variance /= items.size();
+   }
+
+   return got.count == items.size() && close_to(got.sum, sum)
+          && close_to(got.min, smallest) && close_to(got.max, largest)
+          && close_to(got.mean, mean) && close_to(got.variance, variance);
+}
+
+// Returns the i-th of a fixed run of pseudo-random items near 1e6
+double item(sequence::size_type i)
+{
+   return 1e6 + double((i * 2654435761u) % 100003) / 7.0;
+}
+
+int main()
+{
+   const size_t N = 3 * sequence::STATS_MIN_PER_THREAD + 123;
+   const size_t GAPS[] = { 0, 1000, sequence::STATS_MIN_PER_THREAD,
+                           N / 2, N - 1 };
+
+   sequence empty(1, sequence::GAP_BUFFER);
+   const sequence::statistics& none = empty.stats();
+   report("empty sequence",
+          none.count == 0 && none.sum == 0
+          && std::isnan(none.min) && std::isnan(none.max)
+          && std::isnan(none.mean) && std::isnan(none.variance));
+
+   // The same items with the gap in different places
+   sequence plain = make_sequence(N, N / 2, sequence::CONTIGUOUS, item);
+   report("CONTIGUOUS, " + to_string(N) + " items", matches_naive(plain));
+   for (size_t g = 0; g < sizeof(GAPS) / sizeof(GAPS[0]); ++g)
+   {
+      sequence s = make_sequence(N, GAPS[g], sequence::GAP_BUFFER, item);
+      report("GAP_BUFFER, gap at " + to_string(GAPS[g]),
+             matches_naive(s) && close_to(s.stats().sum, plain.stats().sum));
+   }
+
+   // Each kind of change, made after the statistics were cached
+   for (int m = 0; m < CHECK_MODE_COUNT; ++m)
+   {
+      string mode = mode_suffix(m);
+      sequence s = make_sequence(1000, 500, CHECK_MODES[m], item);
+      double more[] = { -5.0, 2e6, 3.25 };
+
+      s.stats();
+      s.seek(250);
+      s.insert(-1e3);
+      report("after insert" + mode, matches_naive(s));
+      s.seek(999);
+      s.attach(5e6);
+      report("after attach" + mode, matches_naive(s));
+      s.seek(10);
+      s.insert_range(more, more + 3);
+      report("after insert_range" + mode, matches_naive(s));
+      s.end();
+      s.attach_range(more, more + 3);
+      report("after attach_range" + mode, matches_naive(s));
+      s.seek(251);
+      s.remove_current();
+      s.start();
+      s.remove_current();
+      report("after remove_current" + mode, matches_naive(s));
+
+      // Write access, with stats called while it is out: the second
+      // write must still be seen
+      s.seek(600);
+      s.insert(0.0);
+      s.stats();
+      double* items = s.data();
+      items[3] = -7e6;
+      report("after a write through data()" + mode, matches_naive(s));
+      items[4] = 9e6;
+      report("after a second write through data()" + mode, matches_naive(s));
+
+      s.seek(300);
+      s.insert(0.0);
+      s.stats();
+      sequence::iterator it = s.items_begin();
+      it[700] = 8e6;
+      report("after a write through items_begin()" + mode, matches_naive(s));
+      *(it + 701) = -8e6;
+      report("after a second write through items_begin()" + mode,
+             matches_naive(s));
+
+      // Statistics cached once the write access is gone still follow
+      // the next change
+      s.remove_current();
+      report("after write access ends" + mode, matches_naive(s));
+      s.seek(0);
+      s.insert(1e7);
+      report("after the next insert" + mode, matches_naive(s));
+   }
+
+   return check_status();
+}
@@ -0,0 +1,173 @@
+// FILE: SequenceView.cpp
+// CLASS IMPLEMENTED: sequence_view (see SequenceView.h for documentation)
+// INVARIANT for the sequence_view class:
+//   1. A closed view has no mapping: mapping is NULL, and mapping_size,
+//      used and current_index are 0 (items is NULL).
+//   2. An open view has the whole snapshot file mapped read-only at
+//      mapping (mapping_size bytes, the size of the file); its header
+//      passed check_header. items points just past the header, and used
+//      is the header's count.
+//   3. current_index is the position of the current item, or used if
+//      there is no current item (as for sequence).
+
+#include <cassert>
+#include <cstring>
+#include <fcntl.h>
+#include "SequenceFile.h"
+#include "SequenceView.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+using namespace std;
+
+namespace CS3358_FA2019
+{
+   // CONSTRUCTORS and DESTRUCTOR
+   sequence_view::sequence_view() : mapping(NULL), mapping_size(0),
+   items(NULL), used(0), current_index(0)
+   {
+   }
+
+   sequence_view::sequence_view(sequence_view&& source) noexcept
+   : mapping(source.mapping), mapping_size(source.mapping_size),
+   items(source.items), used(source.used),
+   current_index(source.current_index)
+   {
+      // Leaving source closed
+      source.mapping = NULL;
+      source.mapping_size = 0;
+      source.items = NULL;
+      source.used = 0;
+      source.current_index = 0;
+   }
+
+   sequence_view::~sequence_view()
+   {
+      close();
+   }
+
+   // MODIFICATION MEMBER FUNCTIONS
+   bool sequence_view::open(const char file_name[])
+   {
+      int fd = ::open(file_name, O_RDONLY);
+      if (fd < 0)
+      {
+         return false;
+      }
+
+      // Mapping the whole file (the mapping outlives the descriptor)
+      struct stat file_status;
+      void* new_mapping = MAP_FAILED;
+      if (fstat(fd, &file_status) == 0
+          && file_status.st_size >= off_t(sizeof(sequence_file_header)))
+      {
+         new_mapping = mmap(NULL, size_t(file_status.st_size), PROT_READ,
+                            MAP_SHARED, fd, 0);
+      }
+      ::close(fd);
+      if (new_mapping == MAP_FAILED)
+      {
+         return false;
+      }
+
+      sequence_file_header header;
+      memcpy(&header, new_mapping, sizeof(header));
+      if (!check_header(header, file_status.st_size))
+      {
+         munmap(new_mapping, size_t(file_status.st_size));
+         return false;
+      }
+
+      // Replacing the old mapping (if any) with the new one
+      close();
+      mapping = new_mapping;
+      mapping_size = size_t(file_status.st_size);
+      items = reinterpret_cast<const value_type*>(
+                 static_cast<const char*>(mapping) + sizeof(header));
+      used = header.count;
+      current_index = header.current_index;
+      return true;
+   }
+
+   void sequence_view::close()
+   {
+      if (mapping != NULL)
+      {
+         munmap(mapping, mapping_size);
+      }
+      mapping = NULL;
+      mapping_size = 0;
+      items = NULL;
+      used = 0;
+      current_index = 0;
+   }
+
+   void sequence_view::start()
+   {
+      current_index = 0;
+   }
+
+   void sequence_view::advance()
+   {
+      // Validating pre-condition
+      assert(is_item());
+
+      current_index = current_index + 1;
+   }
+
+   sequence_view& sequence_view::operator=(sequence_view source) noexcept
+   {
+      // source was moved from the right-hand side; the old mapping goes
+      // to source's destructor
+      swap(source);
+      return *this;
+   }
+
+   void sequence_view::swap(sequence_view& other) noexcept
+   {
+      std::swap(mapping, other.mapping);
+      std::swap(mapping_size, other.mapping_size);
+      std::swap(items, other.items);
+      std::swap(used, other.used);
+      std::swap(current_index, other.current_index);
+   }
+
+   // CONSTANT MEMBER FUNCTIONS
+   bool sequence_view::is_open() const
+   {
+      return mapping != NULL;
+   }
+
+   sequence_view::size_type sequence_view::size() const
+   {
+      return used;
+   }
+
+   bool sequence_view::is_item() const
+   {
+      return (current_index != used);
+   }
+
+   sequence_view::value_type sequence_view::current() const
+   {
+      // Validating pre-condition
+      assert(is_item());
+      return items[current_index];
+   }
+
+   sequence_view::const_iterator sequence_view::items_begin() const
+   {
+      return items;
+   }
+
+   sequence_view::const_iterator sequence_view::items_end() const
+   {
+      return items + used;
+   }
+
+   const sequence_view::value_type* sequence_view::data() const
+   {
+      return items;
+   }
+}
@@ -0,0 +1,132 @@
+// FILE: SequenceView.h
+// CLASS PROVIDED: sequence_view (part of the namespace CS3358_FA2019)
+//
+// A sequence_view is a read-only sequence whose items are those of a
+// snapshot file written by sequence::save (see SequenceFile.h). open
+// memory-maps the file instead of reading it, so:
+//   - opening costs the same for any size of snapshot (only the header
+//     is checked); the pages holding the items are read from disk when
+//     they are first used, and
+//   - every program viewing the same snapshot shares one copy of those
+//     pages (the operating system's file cache) rather than each having
+//     its own dynamic array.
+// The view has its own cursor (start, advance, is_item, current, which
+// behave as in sequence), which open sets to the snapshot's current item.
+// To get a sequence that can be changed, attach the items to one:
+//   s.attach_range(view.data(), view.data() + view.size());
+//   NOTE: sequence_view uses the POSIX open/mmap calls. The snapshot file
+//         must not be changed in place while it is open (sequence::save
+//         replaces files by renaming a new one over them, which is safe).
+//
+// TYPEDEFS for the sequence_view class:
+//   typedef ____ value_type
+//   typedef ____ size_type
+//    The same as sequence::value_type and sequence::size_type.
+//
+//   typedef ____ const_iterator
+//    A random-access iterator over the items (a pointer to const
+//    value_type).
+//
+// CONSTRUCTORS for the sequence_view class:
+//   sequence_view()
+//    Pre:  none
+//    Post: The view is closed (and so is an empty sequence).
+//
+//   sequence_view(sequence_view&& source) noexcept
+//    Pre:  none
+//    Post: The view has taken over source's mapping and cursor; source
+//      is left closed.
+//
+// MODIFICATION MEMBER FUNCTIONS for the sequence_view class:
+//   bool open(const char file_name[])
+//    Pre:  none
+//    Post: If file_name is a snapshot written by sequence::save, the view
+//      (after closing whatever it had open) now shows the items and
+//      current item saved there, and true is returned. Otherwise false
+//      is returned and the view is unchanged.
+//
+//   void close()
+//    Pre:  none
+//    Post: The file the view had open (if any) has been unmapped; the
+//      view is closed and empty.
+//
+//   void start()
+//   void advance()
+//    As for sequence.
+//
+//   void swap(sequence_view& other) noexcept
+//    Pre:  none
+//    Post: The mappings and cursors of the view and other have been
+//      exchanged.
+//
+// CONSTANT MEMBER FUNCTIONS for the sequence_view class:
+//   bool is_open() const
+//    Pre:  none
+//    Post: true is returned if the view has a snapshot open.
+//
+//   size_type size() const
+//   bool is_item() const
+//   value_type current() const
+//    As for sequence.
+//
+//   const_iterator items_begin() const
+//   const_iterator items_end() const
+//    Pre:  none
+//    Post: A pointer to the first item (items_begin) or just past the
+//      last item (items_end) is returned.
+//
+//   const value_type* data() const
+//    Pre:  none
+//    Post: A pointer to the items (data()[0] through data()[size()-1]),
+//      which are stored contiguously in the mapping, is returned. It
+//      stays valid until the view is closed, reopened or destroyed.
+//
+// VALUE SEMANTICS for the sequence_view class:
+//   A sequence_view can't be copied (each open file is mapped by one
+//   view), but it may be moved; assignment takes its right-hand side by
+//   value, so it accepts only rvalues, and closes the old file.
+
+#ifndef SEQUENCE_VIEW_H
+#define SEQUENCE_VIEW_H
+#include <cstdlib>  // provides size_t
+#include "Sequence.h"
+
+namespace CS3358_FA2019
+{
+   class sequence_view
+   {
+   public:
+      // TYPEDEFS
+      typedef sequence::value_type value_type;
+      typedef sequence::size_type size_type;
+      typedef const value_type* const_iterator;
+      // CONSTRUCTORS and DESTRUCTOR
+      sequence_view();
+      sequence_view(const sequence_view& source) = delete;
+      sequence_view(sequence_view&& source) noexcept;
+      ~sequence_view();
+      // MODIFICATION MEMBER FUNCTIONS
+      bool open(const char file_name[]);
+      void close();
+      void start();
+      void advance();
+      sequence_view& operator=(sequence_view source) noexcept;
+      void swap(sequence_view& other) noexcept;
+      // CONSTANT MEMBER FUNCTIONS
+      bool is_open() const;
+      size_type size() const;
+      bool is_item() const;
+      value_type current() const;
+      const_iterator items_begin() const;
+      const_iterator items_end() const;
+      const value_type* data() const;
+   private:
+      void* mapping;
+      size_type mapping_size;
+      const value_type* items;
+      size_type used;
+      size_type current_index;
+   };
+}
+
+#endif
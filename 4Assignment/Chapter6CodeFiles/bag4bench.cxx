@@ -0,0 +1,119 @@
+// FILE: bag4bench.cxx
+// A benchmark program for the count and erase functions of bag<Item> from
+// bag4.h, on bags of N items for char, int and double items (values from 0
+// to 99, so a target is about 1% of the bag). For each type it times:
+//   count  - count of a target, REPEATS times (using the SIMD kernel, see
+//            bag4.h), and the same count done by a loop over the items (as
+//            count did before the kernels)
+//   erase  - erase of a target from a copy of the bag, REPEATS times (after
+//            the first copy of the target every later item is moved too,
+//            and for char about one 16-byte vector in seven holds a copy
+//            and is packed one item at a time, so erase is slower than count)
+// and writes the time per call and the gigabytes of items read per second
+// to cout (the count loop is marked noinline, so it is compiled the same
+// whether or not the compiler would vectorize it inline).
+
+#include <chrono>      // Provides steady_clock
+#include <cstdlib>     // Provides EXIT_SUCCESS, size_t, rand
+#include <iomanip>     // Provides setw, setprecision
+#include <iostream>    // Provides cout
+#include "bag4.h"
+using namespace std;
+using namespace main_savitch_6A;
+
+const size_t N = 10000000;  // Items in each bag
+const int REPEATS = 10;     // Calls timed for each test
+
+// PROTOTYPES for functions used by this benchmark program:
+
+template <class Item>
+size_t count_loop(const Item* items, size_t n, const Item& target)
+    __attribute__((noinline));
+// Postcondition: The return value is the number of times target is in
+// items[0] through items[n-1], found one item at a time.
+
+double seconds_since(chrono::steady_clock::time_point start);
+// Postcondition: The return value is the time in seconds from start to now.
+
+template <class Item>
+void bench_type(const char name[ ]);
+// Postcondition: The count and erase tests (see the top of this file) have
+// been timed on a bag of N Item items, and a row of results has been
+// written to cout.
+
+int main( )
+{
+    cout << N << " items, " << REPEATS << " calls per test" << endl;
+    cout << setw(8) << "item" << setw(8) << "simd"
+         << setw(12) << "count ms" << setw(10) << "GB/s"
+         << setw(12) << "loop ms" << setw(10) << "GB/s"
+         << setw(12) << "erase ms" << setw(10) << "GB/s" << endl;
+    bench_type<char>("char");
+    bench_type<int>("int");
+    bench_type<double>("double");
+    return EXIT_SUCCESS;
+}
+
+template <class Item>
+size_t count_loop(const Item* items, size_t n, const Item& target)
+{
+    size_t answer = 0;
+
+    for (size_t i = 0; i < n; ++i)
+        if (target == items[i])
+            ++answer;
+    return answer;
+}
+
+double seconds_since(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now( ) - start).count( );
+}
+
+template <class Item>
+void bench_type(const char name[ ])
+{
+    bag<Item> b(N);
+    Item *items = new Item[N];
+    size_t i, simd_answer = 0, loop_answer = 0, removed = 0;
+    double count_time, loop_time, erase_time = 0;
+    chrono::steady_clock::time_point start;
+    int r;
+
+    for (i = 0; i < N; ++i)
+    {
+        items[i] = Item(rand( ) % 100);
+        b.insert(items[i]);
+    }
+
+    start = chrono::steady_clock::now( );
+    for (r = 0; r < REPEATS; ++r)
+        simd_answer += b.count(Item(r));
+    count_time = seconds_since(start) / REPEATS;
+
+    start = chrono::steady_clock::now( );
+    for (r = 0; r < REPEATS; ++r)
+        loop_answer += count_loop(items, N, Item(r));
+    loop_time = seconds_since(start) / REPEATS;
+
+    for (r = 0; r < REPEATS; ++r)
+    {
+        bag<Item> copy(b);
+        start = chrono::steady_clock::now( );
+        removed += copy.erase(Item(r));
+        erase_time += seconds_since(start);
+    }
+    erase_time /= REPEATS;
+
+    if (simd_answer != loop_answer || removed != simd_answer)
+        cout << "MISMATCH for " << name << endl;
+    delete [ ] items;
+
+    double gigabytes = double(N) * sizeof(Item) / 1e9;
+    cout << fixed << setprecision(2)
+         << setw(8) << name << setw(8) << (use_bag_simd<Item>::value ? "yes" : "no")
+         << setw(12) << count_time * 1e3 << setw(10) << gigabytes / count_time
+         << setw(12) << loop_time * 1e3 << setw(10) << gigabytes / loop_time
+         << setw(12) << erase_time * 1e3 << setw(10) << gigabytes / erase_time
+         << endl;
+}
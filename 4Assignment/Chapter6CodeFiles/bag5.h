@@ -17,10 +17,14 @@
 //   bag<Item>::iterator and bag<Item>::const_iterator
 //     Forward iterators for a bag or a const bag.
 //   
-// CONSTRUCTOR for the bag<Item> class:
+// CONSTRUCTORS for the bag<Item> class:
 //   bag( )
 //     Postcondition: The bag is empty.
 //
+//   bag(bag&& source)
+//     Postcondition: The bag holds the items that were in source (its nodes
+//     are taken over, not copied), and source is empty.
+//
 // MODIFICATION MEMBER FUNCTIONS for the bag<Item> class:
 //   size_type erase(const Item& target)
 //     Postcondition: All copies of target have been removed from the bag.
@@ -38,6 +42,17 @@
 //   void operator +=(const bag& addend) 
 //     Postcondition: Each item in addend has been added to this bag.
 //
+//   void operator +=(bag&& addend)
+//     Postcondition: Each item in addend has been added to this bag by
+//     splicing addend's list onto this bag's (no node is made or copied), and
+//     addend is empty. This takes time proportional to the smaller of the two
+//     sizes (to find the tail of the shorter list). Adding a bag to itself
+//     this way is the same as with the const bag& version.
+//
+//   void operator =(bag&& source)
+//     Postcondition: The bag holds the items that were in source (its own
+//     items are gone), and source is empty.
+//
 // CONSTANT MEMBER FUNCTIONS for the bag<Item> class:
 //   size_type count(const Item& target) const 
 //     Postcondition: Return value is number of times target is in the bag.
@@ -60,13 +75,24 @@
 //   bag<Item> operator +(const bag<Item>& b1, const bag<Item>& b2) 
 //     Postcondition: The bag returned is the union of b1 and b2.
 //
+//   template <class Item>
+//   bag<Item> operator +(bag<Item>&& b1, const bag<Item>& b2)
+//   bag<Item> operator +(const bag<Item>& b1, bag<Item>&& b2)
+//   bag<Item> operator +(bag<Item>&& b1, bag<Item>&& b2)
+//     Postcondition: The bag returned is the union of b1 and b2. The nodes of
+//     each rvalue operand are spliced into the answer instead of copied (so
+//     b1 + b2 + b3 copies each of b1, b2 and b3 once, and a sum of
+//     temporaries copies nothing); an rvalue operand is left empty.
+//
 // VALUE SEMANTICS for the bag<Item> class:
-//    Assignments and the copy constructor may be used with bag objects.
+//    Assignments and the copy constructor may be used with bag objects. A bag
+//    that is an rvalue (a temporary, or the result of std::move) is moved by
+//    the move constructor and move assignment, which take over its nodes.
 //
 // DYNAMIC MEMORY USAGE by the bag<Item>: 
 //   If there is insufficient dynamic memory, then the following functions throw
-//   bad_alloc: The constructors, insert, operator +=, operator +, and the
-//   assignment operator.
+//   bad_alloc: The default and copy constructors, insert, operator += and
+//   operator + with a const bag& operand, and the copy assignment operator.
 
 #ifndef MAIN_SAVITCH_BAG5_H
 #define MAIN_SAVITCH_BAG5_H
@@ -88,6 +114,7 @@ namespace main_savitch_6B
         // CONSTRUCTORS and DESTRUCTOR
         bag( );
         bag(const bag& source);
+        bag(bag&& source);
         ~bag( );
 	
         // MODIFICATION MEMBER FUNCTIONS
@@ -95,7 +122,9 @@ namespace main_savitch_6B
         bool erase_one(const Item& target);
         void insert(const Item& entry);
         void operator +=(const bag& addend);
+        void operator +=(bag&& addend);
         void operator =(const bag& source);
+        void operator =(bag&& source);
 	
         // CONST MEMBER FUNCTIONS
         size_type count(const Item& target) const;
@@ -120,6 +149,15 @@ namespace main_savitch_6B
     // NONMEMBER functions for the bag
     template <class Item>
     bag<Item> operator +(const bag<Item>& b1, const bag<Item>& b2);
+
+    template <class Item>
+    bag<Item> operator +(bag<Item>&& b1, const bag<Item>& b2);
+
+    template <class Item>
+    bag<Item> operator +(const bag<Item>& b1, bag<Item>&& b2);
+
+    template <class Item>
+    bag<Item> operator +(bag<Item>&& b1, bag<Item>&& b2);
 }
 
 // The implementation of a template class must be included in its header file:
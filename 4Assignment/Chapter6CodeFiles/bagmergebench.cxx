@@ -0,0 +1,89 @@
+// FILE: bagmergebench.cxx
+// A benchmark program for merging two bags of N int items each:
+//   bag4 +   - b1 + b2 for the array bag of bag4.h (one reserve, then the
+//              items copied by up to one thread per hardware thread, since
+//              MAIN_SAVITCH_BAG_THREADS is defined below)
+//   bag4 +=  - b1 += b2 (on a copy of b1)
+//   bag5 +   - b1 + b2 for the linked list bag of bag5.h (every node copied)
+//   bag5 &&  - std::move(b1) + std::move(b2) (on copies of b1 and b2): the
+//              nodes are spliced together, none copied
+// The time of each (the copies of the operands are not timed) is written to
+// cout. Must be built with -pthread.
+
+#include <chrono>      // Provides steady_clock
+#include <cstdlib>     // Provides EXIT_SUCCESS, size_t, rand
+#include <iomanip>     // Provides setw, setprecision
+#include <iostream>    // Provides cout
+#include <thread>      // Provides thread
+#include <utility>     // Provides move
+#define MAIN_SAVITCH_BAG_THREADS  // Lets bag4's += copy with threads
+#include "bag4.h"
+#include "bag5.h"
+using namespace std;
+
+const size_t N = 10000000;  // Items in each bag
+
+// PROTOTYPES for functions used by this benchmark program:
+
+double seconds_since(chrono::steady_clock::time_point start);
+// Postcondition: The return value is the time in seconds from start to now.
+
+void report(const char name[ ], double seconds, size_t items);
+// Postcondition: A row with name, the time in milliseconds and the millions
+// of items per second has been written to cout.
+
+int main( )
+{
+    main_savitch_6A::bag<int> a1(N), a2(N);
+    main_savitch_6B::bag<int> l1, l2;
+    chrono::steady_clock::time_point start;
+    size_t i;
+
+    for (i = 0; i < N; ++i)
+    {
+        a1.insert(rand( ) % 1000);
+        a2.insert(rand( ) % 1000);
+        l1.insert(rand( ) % 1000);
+        l2.insert(rand( ) % 1000);
+    }
+
+    cout << N << " + " << N << " items, " << thread::hardware_concurrency( )
+         << " hardware threads" << endl;
+    cout << setw(10) << "merge" << setw(12) << "ms" << setw(14) << "Mitems/s"
+         << endl;
+    {
+        start = chrono::steady_clock::now( );
+        main_savitch_6A::bag<int> sum = a1 + a2;
+        report("bag4 +", seconds_since(start), sum.size( ));
+    }
+    {
+        main_savitch_6A::bag<int> sum(a1);
+        start = chrono::steady_clock::now( );
+        sum += a2;
+        report("bag4 +=", seconds_since(start), sum.size( ));
+    }
+    {
+        start = chrono::steady_clock::now( );
+        main_savitch_6B::bag<int> sum = l1 + l2;
+        report("bag5 +", seconds_since(start), sum.size( ));
+    }
+    {
+        main_savitch_6B::bag<int> c1(l1), c2(l2);
+        start = chrono::steady_clock::now( );
+        main_savitch_6B::bag<int> sum = move(c1) + move(c2);
+        report("bag5 &&", seconds_since(start), sum.size( ));
+    }
+    return EXIT_SUCCESS;
+}
+
+double seconds_since(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now( ) - start).count( );
+}
+
+void report(const char name[ ], double seconds, size_t items)
+{
+    cout << fixed << setprecision(2) << setw(10) << name
+         << setw(12) << seconds * 1e3 << setw(14) << items / seconds / 1e6
+         << endl;
+}
@@ -0,0 +1,224 @@
+// FILE: hashbag.h (part of the namespace main_savitch_6B)
+// TEMPLATE CLASS PROVIDED:
+//   hashed_bag<Item, Hash> (a collection of items; each item may appear
+//   multiple times)
+//
+// hashed_bag has the interface of bag<Item> from bag5.h, but instead of a
+// linked list with one node per item it keeps a hash table with one entry per
+// distinct item, holding the item and the number of copies of it. So:
+//   - insert, count, erase and erase_one take O(1) expected time (bag5's
+//     count, erase and erase_one search the whole list), and
+//   - a bag of many copies of few distinct items (as in frequency counting)
+//     takes memory for the distinct items only.
+// The table uses open addressing with linear probing: the entries are kept in
+// one dynamic array (no node per entry), which is doubled when it becomes
+// three quarters full. It does not shrink when items are erased.
+//
+// TEMPLATE PARAMETERS:
+//   Item - the data type of the items (see value_type below).
+//   Hash - a function object type whose operator( ) takes an Item and returns
+//          a std::size_t, equal for equal items (default std::hash<Item>).
+//
+// TYPEDEFS for the hashed_bag<Item, Hash> template class:
+//   hashed_bag<Item, Hash>::value_type
+//     This is the Item type from the template parameter.
+//     It is the data type of the items in the bag. It may be any
+//     of the C++ built-in types (int, char, etc.), or a class with a default
+//     constructor, a copy constructor, an assignment
+//     operator, and a test for equality (x == y).
+//
+//   hashed_bag<Item, Hash>::size_type
+//     This is the data type of any variable that keeps track of how many items
+//     are in a bag
+//
+//   hashed_bag<Item, Hash>::iterator and hashed_bag<Item, Hash>::const_iterator
+//     Forward iterators for a bag or a const bag. Both give read-only access
+//     (changing an item in place could move it in the table). The copies of
+//     each item come one after another; the order of the distinct items is
+//     unspecified. Any change to the bag invalidates all iterators.
+//
+// CONSTRUCTOR for the hashed_bag<Item, Hash> class:
+//   hashed_bag( )
+//     Postcondition: The bag is empty (and has no table yet).
+//
+// MODIFICATION MEMBER FUNCTIONS for the hashed_bag<Item, Hash> class:
+//   size_type erase(const Item& target)
+//     Postcondition: All copies of target have been removed from the bag.
+//     The return value is the number of copies removed (which could be zero).
+//
+//   bool erase_one(const Item& target)
+//     Postcondition: If target was in the bag, then one copy of target has
+//     been removed from the bag; otherwise the bag is unchanged. A true
+//     return value indicates that one copy was removed; false indicates that
+//     nothing was removed.
+//
+//   void insert(const Item& entry)
+//     Postcondition: A new copy of entry has been inserted into the bag.
+//
+//   void insert(const Item& entry, size_type copies)
+//     Postcondition: copies new copies of entry have been inserted into the
+//     bag (in O(1) expected time, however many copies).
+//
+//   void reserve(size_type distinct_items)
+//     Postcondition: The table is large enough for distinct_items distinct
+//     items, so inserting up to that many will not enlarge it again.
+//
+//   void operator +=(const hashed_bag& addend)
+//     Postcondition: Each item in addend has been added to this bag. This
+//     takes time proportional to addend's number of distinct items.
+//
+// CONSTANT MEMBER FUNCTIONS for the hashed_bag<Item, Hash> class:
+//   size_type count(const Item& target) const
+//     Postcondition: Return value is number of times target is in the bag.
+//
+//   Item grab( ) const
+//     Precondition: size( ) > 0.
+//     Postcondition: The return value is a randomly selected item from the bag
+//     (each copy is equally likely). This takes time proportional to the size
+//     of the table.
+//
+//   size_type size( ) const
+//     Postcondition: Return value is the total number of items in the bag.
+//
+//   size_type distinct( ) const
+//     Postcondition: Return value is the number of different items in the bag.
+//
+// STANDARD ITERATOR MEMBER FUNCTIONS (provide a forward iterator):
+//   iterator begin( ) const
+//   iterator end( ) const
+//
+// NONMEMBER FUNCTIONS for the hashed_bag<Item, Hash> class:
+//   template <class Item, class Hash>
+//   hashed_bag<Item, Hash> operator +
+//     (const hashed_bag<Item, Hash>& b1, const hashed_bag<Item, Hash>& b2)
+//     Postcondition: The bag returned is the union of b1 and b2.
+//
+// VALUE SEMANTICS for the hashed_bag<Item, Hash> class:
+//    Assignments and the copy constructor may be used with hashed_bag objects.
+//
+// DYNAMIC MEMORY USAGE by the hashed_bag<Item, Hash>:
+//   If there is insufficient dynamic memory, then the following functions throw
+//   bad_alloc: The copy constructor, insert, reserve, operator +=, operator +,
+//   and the assignment operator. If the table can't be enlarged, the bag is
+//   unchanged.
+
+#ifndef MAIN_SAVITCH_HASHBAG_H
+#define MAIN_SAVITCH_HASHBAG_H
+#include <cstdlib>     // Provides NULL and size_t
+#include <functional>  // Provides hash
+#include <iterator>    // Provides iterator and forward_iterator_tag
+#include <utility>     // Provides move_if_noexcept, swap
+
+namespace main_savitch_6B
+{
+    template <class Item, class Hash = std::hash<Item> >
+    class hashed_bag
+    {
+    private:
+        struct slot
+        {
+            Item data;               // The item
+            std::size_t copies;      // How many copies (0 for an empty entry)
+        };
+    public:
+        // TYPEDEFS
+        typedef std::size_t size_type;
+        typedef Item value_type;
+        class const_iterator;
+        typedef const_iterator iterator;
+
+        // CONSTRUCTORS and DESTRUCTOR
+        hashed_bag( );
+        hashed_bag(const hashed_bag& source);
+        ~hashed_bag( );
+
+        // MODIFICATION MEMBER FUNCTIONS
+        size_type erase(const Item& target);
+        bool erase_one(const Item& target);
+        void insert(const Item& entry);
+        void insert(const Item& entry, size_type copies);
+        void reserve(size_type distinct_items);
+        void operator +=(const hashed_bag& addend);
+        void operator =(const hashed_bag& source);
+
+        // CONST MEMBER FUNCTIONS
+        size_type count(const Item& target) const;
+        Item grab( ) const;
+        size_type size( ) const { return many_items; }
+        size_type distinct( ) const { return many_distinct; }
+
+        // FUNCTIONS TO PROVIDE ITERATORS
+        iterator begin( ) const
+            { return iterator(table, table + capacity); }
+        iterator end( ) const
+            { return iterator(table + capacity, table + capacity); }
+
+        // A forward iterator that visits each entry's item copies times
+        class const_iterator
+        : public std::iterator<std::forward_iterator_tag, const Item>
+        {
+        public:
+            const_iterator( )
+                { current = NULL; stop = NULL; repeat = 0; }
+            const_iterator(const slot* first, const slot* last)
+                { current = first; stop = last; repeat = 0; skip_empty( ); }
+            const Item& operator *( ) const
+                { return current->data; }
+            const_iterator& operator ++( ) // Prefix ++
+                {
+                    if (++repeat == current->copies)
+                    {
+                        repeat = 0;
+                        ++current;
+                        skip_empty( );
+                    }
+                    return *this;
+                }
+            const_iterator operator ++(int) // Postfix ++
+                {
+                    const_iterator original(*this);
+                    ++*this;
+                    return original;
+                }
+            bool operator ==(const const_iterator other) const
+                { return current == other.current && repeat == other.repeat; }
+            bool operator !=(const const_iterator other) const
+                { return !(*this == other); }
+        private:
+            void skip_empty( )
+                {
+                    while (current != stop && current->copies == 0)
+                        ++current;
+                }
+            const slot* current;   // The entry being visited
+            const slot* stop;      // Just past the last entry of the table
+            std::size_t repeat;     // Copies of current already visited
+        };
+
+    private:
+        static const std::size_t MIN_CAPACITY = 16;
+        slot *table;                 // The dynamic array of entries
+        size_type capacity;          // Number of entries (0 or a power of 2)
+        int shift;                   // 64 - log2(capacity), for home( )
+        size_type many_distinct;     // Number of non-empty entries
+        size_type many_items;        // Total number of items (copies)
+        Hash hasher;
+
+        // HELPER FUNCTIONS
+        size_type home(const Item& target) const;
+        size_type find(const Item& target) const;
+        size_type add(const Item& entry);
+        void remove_entry(size_type i);
+        void rehash(size_type new_capacity);
+        void swap(hashed_bag& other);
+    };
+
+    // NONMEMBER functions for the hashed_bag
+    template <class Item, class Hash>
+    hashed_bag<Item, Hash> operator +
+        (const hashed_bag<Item, Hash>& b1, const hashed_bag<Item, Hash>& b2);
+}
+
+// The implementation of a template class must be included in its header file:
+#include "hashbag.template"
+#endif
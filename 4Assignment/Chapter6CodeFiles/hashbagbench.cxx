@@ -0,0 +1,186 @@
+// FILE: hashbagbench.cxx
+// A benchmark and check program for hashed_bag<Item> from hashbag.h, on a
+// frequency-counting workload: N items drawn from DISTINCT different values
+// are inserted, and then each of the values is counted. It times:
+//   hashed_bag     - insert and count on a hashed_bag<int>
+//   unordered_map  - the same work on a std::unordered_map<int, size_t>
+//                    (++map[item] and map.find(value))
+// Then, on a smaller bag (CHECK_N items from CHECK_DISTINCT values, of int
+// and of std::string items), it does the same inserts, erase_one, erase,
+// += and counts on a hashed_bag and on bag5's bag, times the counts of both
+// (bag5's count searches its whole list), and checks that every result
+// agrees, and that both bags iterate over the same items.
+// The times are written to cout, and the program exits with EXIT_FAILURE if
+// any check fails.
+
+#include <chrono>         // Provides steady_clock
+#include <cstdlib>        // Provides EXIT_SUCCESS, EXIT_FAILURE, size_t, rand
+#include <iomanip>        // Provides setw, setprecision
+#include <iostream>       // Provides cout
+#include <map>            // Provides map
+#include <string>         // Provides string, to_string
+#include <unordered_map>  // Provides unordered_map
+#include "bag5.h"
+#include "hashbag.h"
+using namespace std;
+using namespace main_savitch_6B;
+
+const size_t N = 20000000;        // Items inserted in the timed workload
+const int DISTINCT = 1000000;     // Different values among them
+const size_t CHECK_N = 20000;     // Items in the bags checked against bag5
+const int CHECK_DISTINCT = 500;   // Different values among them
+
+// PROTOTYPES for functions used by this benchmark program:
+
+double seconds_since(chrono::steady_clock::time_point start);
+// Postcondition: The return value is the time in seconds from start to now.
+
+void report(const char name[ ], double seconds, size_t operations);
+// Postcondition: A row with name, the time in milliseconds and the millions
+// of operations per second has been written to cout.
+
+int int_item(int i);
+string string_item(int i);
+// Postcondition: The return value is the item made from i (i itself, or
+// "item" followed by i); different values of i give different items.
+
+template <class Bag>
+map<typename Bag::value_type, size_t> tally(const Bag& b);
+// Postcondition: The return value maps each item of b to the number of
+// times b's iterators visit it.
+
+template <class Item>
+bool check_against_bag5(const char name[ ], Item make(int));
+// Postcondition: The check described at the top of this file has been done
+// for Item items made by make, the time of the counts has been written to
+// cout, and true has been returned if every result agreed.
+
+int main( )
+{
+    hashed_bag<int> counts;
+    unordered_map<int, size_t> map_counts;
+    chrono::steady_clock::time_point start;
+    size_t i, found;
+    int value;
+    bool ok;
+
+    cout << N << " items from " << DISTINCT << " values, then "
+         << DISTINCT << " counts" << endl;
+    cout << setw(18) << "bag" << setw(12) << "ms" << setw(14) << "Mops/s"
+         << endl;
+
+    srand(1);
+    found = 0;
+    start = chrono::steady_clock::now( );
+    for (i = 0; i < N; ++i)
+        counts.insert(rand( ) % DISTINCT);
+    for (value = 0; value < DISTINCT; ++value)
+        found += counts.count(value);
+    report("hashed_bag", seconds_since(start), N + DISTINCT);
+    ok = (found == N && counts.size( ) == N);
+
+    srand(1);
+    found = 0;
+    start = chrono::steady_clock::now( );
+    for (i = 0; i < N; ++i)
+        ++map_counts[rand( ) % DISTINCT];
+    for (value = 0; value < DISTINCT; ++value)
+    {
+        unordered_map<int, size_t>::const_iterator it = map_counts.find(value);
+        if (it != map_counts.end( ))
+            found += it->second;
+    }
+    report("unordered_map", seconds_since(start), N + DISTINCT);
+    ok = ok && found == N && map_counts.size( ) == counts.distinct( );
+
+    cout << endl << CHECK_N << " items from " << CHECK_DISTINCT
+         << " values, checked against bag5 (time of the counts)" << endl;
+    ok = check_against_bag5("int", int_item) && ok;
+    ok = check_against_bag5("string", string_item) && ok;
+
+    cout << (ok ? "All results agree" : "MISMATCH") << endl;
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+double seconds_since(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now( ) - start).count( );
+}
+
+void report(const char name[ ], double seconds, size_t operations)
+{
+    cout << fixed << setprecision(2) << setw(18) << name
+         << setw(12) << seconds * 1e3 << setw(14) << operations / seconds / 1e6
+         << endl;
+}
+
+int int_item(int i)
+{
+    return i;
+}
+
+string string_item(int i)
+{
+    return "item" + to_string(i);
+}
+
+template <class Bag>
+map<typename Bag::value_type, size_t> tally(const Bag& b)
+{
+    map<typename Bag::value_type, size_t> answer;
+    typename Bag::const_iterator it;
+
+    for (it = b.begin( ); it != b.end( ); ++it)
+        ++answer[*it];
+    return answer;
+}
+
+template <class Item>
+bool check_against_bag5(const char name[ ], Item make(int))
+{
+    hashed_bag<Item> hashed;
+    bag<Item> listed;
+    chrono::steady_clock::time_point start;
+    double hashed_time, listed_time;
+    size_t i, hashed_found, listed_found;
+    int value;
+    bool ok = true;
+
+    srand(2);
+    for (i = 0; i < CHECK_N; ++i)
+    {
+        Item entry = make(rand( ) % CHECK_DISTINCT);
+        hashed.insert(entry);
+        listed.insert(entry);
+    }
+    for (value = 0; value < CHECK_DISTINCT; value += 3)
+        ok = ok && hashed.erase_one(make(value)) == listed.erase_one(make(value));
+    for (value = 0; value < CHECK_DISTINCT; value += 7)
+        ok = ok && hashed.erase(make(value)) == listed.erase(make(value));
+    hashed += hashed_bag<Item>(hashed);
+    listed += bag<Item>(listed);
+
+    // Counting every value (and a few that were never inserted)
+    hashed_found = listed_found = 0;
+    start = chrono::steady_clock::now( );
+    for (value = 0; value < CHECK_DISTINCT + 10; ++value)
+        hashed_found += hashed.count(make(value));
+    hashed_time = seconds_since(start);
+    start = chrono::steady_clock::now( );
+    for (value = 0; value < CHECK_DISTINCT + 10; ++value)
+        listed_found += listed.count(make(value));
+    listed_time = seconds_since(start);
+    for (value = 0; value < CHECK_DISTINCT + 10; ++value)
+        ok = ok && hashed.count(make(value)) == listed.count(make(value));
+
+    ok = ok && hashed_found == listed_found && hashed.size( ) == listed.size( )
+        && hashed_found == hashed.size( ) && tally(hashed) == tally(listed);
+
+    string hashed_name = string("hashed_bag ") + name;
+    string listed_name = string("bag5 ") + name;
+    report(hashed_name.c_str( ), hashed_time, CHECK_DISTINCT + 10);
+    report(listed_name.c_str( ), listed_time, CHECK_DISTINCT + 10);
+    if (!ok)
+        cout << "MISMATCH for " << name << endl;
+    return ok;
+}
@@ -74,7 +74,8 @@
 //   void list_clear(node<Item>*& head_ptr) 
 //     Precondition: head_ptr is the head pointer of a linked list.
 //     Postcondition: All nodes of the list have been returned to the heap,
-//     and the head_ptr is now NULL.
+//     and the head_ptr is now NULL. (When node<Item> uses the node pool, the
+//     whole list is put on the pool's free list at once; see NODE POOL.)
 //
 //   template <class Item>
 //   void list_copy
@@ -139,14 +140,110 @@
 // DYNAMIC MEMORY usage by the toolkit: 
 //   If there is insufficient dynamic memory, then the following functions throw
 //   bad_alloc: the constructor, list_head_insert, list_insert, list_copy.
+//
+// NODE POOL:
+//   new node<Item> and delete take nodes from (and give them back to) a pool
+//   shared by all nodes of the same Item type, node_pool<Item>. The pool gets
+//   memory from the heap a slab (about 16 KB of nodes) at a time and keeps
+//   the nodes given back on a free list for reuse, so:
+//     - a node costs a couple of pointer moves instead of a trip through
+//       the heap allocator,
+//     - nodes allocated one after another (by list_copy, say) lie next to
+//       each other in memory, and
+//     - list_clear gives back a whole list in one step.
+//   Slabs are not returned to the heap while any of their nodes are in use;
+//   see purge.
+//   The pool is guarded by a spinlock, so lists of one Item type may be
+//   changed by different threads at the same time (as with the ordinary
+//   new and delete, one list still must not be changed by two threads at
+//   once). The lock is held only for the few pointer moves on the free
+//   list, not while nodes are built or destroyed.
+//   Only memory of exactly sizeof(node<Item>) comes from the pool: a class
+//   derived from node<Item> that is larger gets its memory from the
+//   ordinary new (so a list of such nodes must be given back with delete,
+//   one node at a time, rather than with list_clear).
+//
+//   template <class Item> struct use_node_pool
+//     use_node_pool<Item>::value is true if node<Item> uses the pool. It is
+//     true for every type unless the macro MAIN_SAVITCH_NO_NODE_POOL is
+//     defined before node2.h is included (then it is false for every type).
+//     A single type opts out (or in) with a specialization:
+//       namespace main_savitch_6B
+//       {
+//           template <> struct use_node_pool<my_type>
+//           { static const bool value = false; };
+//       }
+//     Nodes of a type that has opted out use the ordinary new and delete.
+//
+//   struct node_pool_statistics
+//     The numbers kept by a pool (all are 0 until the first node is made):
+//       slabs         - slabs the pool has now
+//       capacity      - nodes the slabs hold
+//       in_use        - nodes made and not yet given back
+//       peak_in_use   - the largest in_use has been
+//       allocations   - nodes made since the program started
+//       list_releases - lists given back in one step by list_clear
+//
+//   STATIC MEMBER FUNCTIONS of the node_pool<Item> class:
+//   All of them lock the pool while they use it.
+//     static void* allocate( )
+//       Postcondition: The return value is memory for one node<Item>, taken
+//       from the free list (a new slab is added to it first if it is empty).
+//       Throws bad_alloc if a new slab is needed and there is no memory.
+//
+//     static void deallocate(void* p)
+//       Precondition: p is NULL or was returned by allocate (and hasn't been
+//       given back), and any node in it has been destroyed.
+//       Postcondition: The memory at p is on the free list.
+//
+//     static void release_list(node<Item>*& head_ptr)
+//       Precondition: head_ptr is the head pointer of a linked list whose
+//       nodes came from the pool.
+//       Postcondition: The nodes have been destroyed and put on the free
+//       list (in list order, with one change to the free list), and head_ptr
+//       is NULL.
+//
+//     static bool purge( )
+//       Postcondition: If no nodes are in use, all slabs have been returned
+//       to the heap and true is returned; otherwise nothing has changed and
+//       false is returned.
+//
+//     static node_pool_statistics statistics( )
+//       Postcondition: The return value holds the pool's numbers.
 
 #ifndef MAIN_SAVITCH_NODE2_H  
 #define MAIN_SAVITCH_NODE2_H
 #include <cstdlib>   // Provides NULL and size_t
 #include <iterator>  // Provides iterator and forward_iterator_tag
+#include <atomic>    // Provides atomic_flag
+#include <new>       // Provides operator new and operator delete
+#include <type_traits>  // Provides aligned_storage
 
 namespace main_savitch_6B
 {
+    template <class Item>
+    struct use_node_pool
+    {
+#ifdef MAIN_SAVITCH_NO_NODE_POOL
+        static const bool value = false;
+#else
+        static const bool value = true;
+#endif
+    };
+
+    struct node_pool_statistics
+    {
+        std::size_t slabs;
+        std::size_t capacity;
+        std::size_t in_use;
+        std::size_t peak_in_use;
+        std::size_t allocations;
+        std::size_t list_releases;
+    };
+
+    template <class Item>
+    class node_pool;
+
     template <class Item>
     class node
     {
@@ -164,11 +261,67 @@ namespace main_savitch_6B
         // CONST MEMBER FUNCTIONS
         const Item& data( ) const { return data_field; }
         const node* link( ) const { return link_field; }
+        // ALLOCATION (see NODE POOL above)
+        static void* operator new(std::size_t bytes)
+        {
+            if (use_node_pool<Item>::value && bytes == sizeof(node))
+                return node_pool<Item>::allocate( );
+            return ::operator new(bytes);
+        }
+        static void operator delete(void* p, std::size_t bytes)
+        {
+            if (use_node_pool<Item>::value && bytes == sizeof(node))
+                node_pool<Item>::deallocate(p);
+            else
+                ::operator delete(p);
+        }
     private:
         Item data_field;
         node *link_field;
     };
 
+    template <class Item>
+    class node_pool
+    {
+    public:
+        static void* allocate( );
+        static void deallocate(void* p);
+        static void release_list(node<Item>*& head_ptr);
+        static bool purge( );
+        static node_pool_statistics statistics( );
+    private:
+        // A free slot holds the link to the next free slot
+        union slot
+        {
+            slot* next_free;
+            typename std::aligned_storage<sizeof(node<Item>),
+                                          alignof(node<Item>)>::type storage;
+        };
+        static const std::size_t SLAB_BYTES = 16384;
+        static const std::size_t SLOTS_PER_SLAB =
+            (SLAB_BYTES / sizeof(slot) > 0) ? SLAB_BYTES / sizeof(slot) : 1;
+        struct slab
+        {
+            slab* next;
+            slot slots[SLOTS_PER_SLAB];
+        };
+        // Holds the lock on the pool while it exists
+        class guard
+        {
+        public:
+            guard( );
+            ~guard( );
+        private:
+            guard(const guard&);
+            void operator =(const guard&);
+        };
+        static slot* free_list;
+        static slab* slabs;
+        static node_pool_statistics counts;
+        static std::atomic_flag locked;
+        static void add_slab( );
+    };
+
     // FUNCTIONS to manipulate a linked list:
     template <class Item>
     void list_clear(node<Item>*& head_ptr);
@@ -0,0 +1,173 @@
+// FILE: ubag.h (part of the namespace main_savitch_6B)
+// TEMPLATE CLASS PROVIDED:
+//   ubag<Item> (a collection of items; each item may appear multiple times)
+//
+// ubag<Item> has the interface of bag<Item> from bag5.h and works the same
+// way, but it keeps its items on an unrolled linked list (see unode.h)
+// instead of a node<Item> list: each node holds up to
+// unrolled_node<Item>::CAPACITY items next to each other. So for small items
+// insert makes a node only once per CAPACITY items, and count, erase and
+// erase_one step through the items of a node as an array, following one link
+// per node instead of one per item (see unodebench.cxx).
+//
+// TYPEDEFS for the ubag<Item> template class:
+//   ubag<Item>::value_type
+//     This is the Item type from the template parameter.
+//     It is the data type of the items in the bag. It may be any
+//     of the C++ built-in types (int, char, etc.), or a class with a default
+//     constructor, a copy constructor, an assignment
+//     operator, and a test for equality (x == y).
+//
+//   ubag<Item>::size_type
+//     This is the data type of any variable that keeps track of how many items
+//     are in a bag
+//
+//   ubag<Item>::iterator and ubag<Item>::const_iterator
+//     Forward iterators for a bag or a const bag (unrolled_node_iterator and
+//     const_unrolled_node_iterator from unode.h).
+//
+// CONSTRUCTORS for the ubag<Item> class:
+//   ubag( )
+//     Postcondition: The bag is empty.
+//
+//   ubag(ubag&& source)
+//     Postcondition: The bag holds the items that were in source (its nodes
+//     are taken over, not copied), and source is empty.
+//
+// MODIFICATION MEMBER FUNCTIONS for the ubag<Item> class:
+//   size_type erase(const Item& target)
+//     Postcondition: All copies of target have been removed from the bag.
+//     The return value is the number of copies removed (which could be zero).
+//
+//   bool erase_one(const Item& target)
+//     Postcondition: If target was in the bag, then one copy of target has
+//     been removed from the bag; otherwise the bag is unchanged. A true
+//     return value indicates that one copy was removed; false indicates that
+//     nothing was removed.
+//
+//   void insert(const Item& entry)
+//     Postcondition: A new copy of entry has been inserted into the bag.
+//
+//   void operator +=(const ubag& addend)
+//     Postcondition: Each item in addend has been added to this bag.
+//
+//   void operator +=(ubag&& addend)
+//     Postcondition: Each item in addend has been added to this bag by
+//     splicing addend's list onto this bag's (no node is made or copied), and
+//     addend is empty. This takes time proportional to the number of nodes
+//     of the shorter list (to find its tail). Adding a bag to itself this way
+//     is the same as with the const ubag& version.
+//
+//   void operator =(ubag&& source)
+//     Postcondition: The bag holds the items that were in source (its own
+//     items are gone), and source is empty.
+//
+// CONSTANT MEMBER FUNCTIONS for the ubag<Item> class:
+//   size_type count(const Item& target) const
+//     Postcondition: Return value is number of times target is in the bag.
+//
+//   Item grab( ) const
+//     Precondition: size( ) > 0.
+//     Postcondition: The return value is a randomly selected item from the bag.
+//
+//   size_type size( ) const
+//     Postcondition: Return value is the total number of items in the bag.
+//
+// STANDARD ITERATOR MEMBER FUNCTIONS (provide a forward iterator):
+//   iterator begin( )
+//   const_iterator begin( ) const
+//   iterator end( )
+//   const iterator end( ) const
+//
+// NONMEMBER FUNCTIONS for the ubag<Item> class:
+//   template <class Item>
+//   ubag<Item> operator +(const ubag<Item>& b1, const ubag<Item>& b2)
+//     Postcondition: The bag returned is the union of b1 and b2.
+//
+//   template <class Item>
+//   ubag<Item> operator +(ubag<Item>&& b1, const ubag<Item>& b2)
+//   ubag<Item> operator +(const ubag<Item>& b1, ubag<Item>&& b2)
+//   ubag<Item> operator +(ubag<Item>&& b1, ubag<Item>&& b2)
+//     Postcondition: The bag returned is the union of b1 and b2. The nodes of
+//     each rvalue operand are spliced into the answer instead of copied; an
+//     rvalue operand is left empty.
+//
+// VALUE SEMANTICS for the ubag<Item> class:
+//    Assignments and the copy constructor may be used with ubag objects. A
+//    ubag that is an rvalue is moved by the move constructor and move
+//    assignment, which take over its nodes.
+//
+// DYNAMIC MEMORY USAGE by the ubag<Item>:
+//   If there is insufficient dynamic memory, then the following functions throw
+//   bad_alloc: The copy constructor, insert, operator += and operator + with a
+//   const ubag& operand, and the copy assignment operator.
+
+#ifndef MAIN_SAVITCH_UBAG_H
+#define MAIN_SAVITCH_UBAG_H
+#include <cstdlib>   // Provides NULL and size_t
+#include "unode.h"   // Provides unrolled_node class
+
+namespace main_savitch_6B
+{
+    template <class Item>
+    class ubag
+    {
+    public:
+        // TYPEDEFS
+	typedef std::size_t size_type;
+        typedef Item value_type;
+	typedef unrolled_node_iterator<Item> iterator;
+	typedef const_unrolled_node_iterator<Item> const_iterator;
+
+        // CONSTRUCTORS and DESTRUCTOR
+        ubag( );
+        ubag(const ubag& source);
+        ubag(ubag&& source);
+        ~ubag( );
+
+        // MODIFICATION MEMBER FUNCTIONS
+        size_type erase(const Item& target);
+        bool erase_one(const Item& target);
+        void insert(const Item& entry);
+        void operator +=(const ubag& addend);
+        void operator +=(ubag&& addend);
+        void operator =(const ubag& source);
+        void operator =(ubag&& source);
+
+        // CONST MEMBER FUNCTIONS
+        size_type count(const Item& target) const;
+        Item grab( ) const;
+        size_type size( ) const { return many_items; }
+
+	// FUNCTIONS TO PROVIDE ITERATORS
+	iterator begin( )
+	    { return iterator(head_ptr); }
+	const_iterator begin( ) const
+	    { return const_iterator(head_ptr); }
+	iterator end( )
+	    { return iterator( ); } // Uses default constructor
+	const_iterator end( ) const
+	    { return const_iterator( ); } // Uses default constructor
+
+    private:
+        unrolled_node<Item> *head_ptr;  // Head pointer for the list of items
+        size_type many_items;           // Number of items on the list
+    };
+
+    // NONMEMBER functions for the ubag
+    template <class Item>
+    ubag<Item> operator +(const ubag<Item>& b1, const ubag<Item>& b2);
+
+    template <class Item>
+    ubag<Item> operator +(ubag<Item>&& b1, const ubag<Item>& b2);
+
+    template <class Item>
+    ubag<Item> operator +(const ubag<Item>& b1, ubag<Item>&& b2);
+
+    template <class Item>
+    ubag<Item> operator +(ubag<Item>&& b1, ubag<Item>&& b2);
+}
+
+// The implementation of a template class must be included in its header file:
+#include "ubag.template"
+#endif
@@ -0,0 +1,292 @@
+// FILE: unode.h (part of the namespace main_savitch_6B)
+// PROVIDES: A template class for a node in an unrolled linked list, list
+// manipulation functions, and forward iterators (unrolled_node_iterator and
+// const_unrolled_node_iterator) that work like node_iterator and
+// const_node_iterator from node2.h.
+//
+// An unrolled linked list is a linked list whose nodes each hold up to
+// CAPACITY items (a small array) instead of one. CAPACITY is chosen so that a
+// node (array, count and link) takes about two 64-byte cache lines. Stepping
+// through the list then follows one link per CAPACITY items instead of one
+// per item, and the items of a node are next to each other in memory, so an
+// iteration has far fewer cache misses; a list of n items also needs about
+// n / CAPACITY allocations instead of n. The gain is for small items: a node
+// holds only a few items as large as a std::string, and each of its unused
+// places is still default-constructed, so for such items a node<Item> list
+// can be as fast or faster (see unodebench.cxx). ubag.h provides a bag with
+// bag5.h's interface built on these lists.
+//
+// TYPEDEF and MEMBER CONSTANT for the unrolled_node<Item> template class:
+//   unrolled_node<Item>::value_type is the Item type from the template
+//   parameter: any of the built-in C++ types or a class with a default
+//   constructor and an assignment operator (every node holds CAPACITY Items,
+//   default-constructed until used).
+//
+//   static const std::size_t CAPACITY
+//     The most items a node holds: (128 - 2 * sizeof(std::size_t)) /
+//     sizeof(Item), but at least 1 (28 for int, 14 for double, 3 for a 32-byte
+//     std::string).
+//
+// CONSTRUCTOR for the unrolled_node<Item> class:
+//   unrolled_node(unrolled_node* init_link = NULL)
+//     Postcondition: The node holds no items and its link is init_link.
+//
+// MEMBER FUNCTIONS for the unrolled_node<Item> class:
+//   Item& data(std::size_t i)  and  const Item& data(std::size_t i) const
+//     Precondition: i < size( ).
+//     Postcondition: The return value is a reference to item i of the node
+//     (item 0 is the first).
+//
+//   Item* items_begin( )  and  const Item* items_begin( ) const
+//   Item* items_end( )  and  const Item* items_end( ) const
+//     Postcondition: The return values point to the first item of the node
+//     and just past its last item (the items are consecutive in the array).
+//
+//   unrolled_node* link( )  and  const unrolled_node* link( ) const
+//     Postcondition: The return value is the link from this node.
+//
+//   void set_link(unrolled_node* new_link)
+//     Postcondition: The node now contains the specified new link.
+//
+//   std::size_t size( ) const
+//     Postcondition: The return value is the number of items in the node.
+//
+//   bool is_full( ) const
+//     Postcondition: true is returned if the node holds CAPACITY items.
+//
+//   void push_front(const Item& entry)
+//     Precondition: is_full( ) is false.
+//     Postcondition: entry is now the first item of the node (the others are
+//     one position later). Takes O(1) time: the items are kept at the end of
+//     the node's array, so the free places are all in front of them.
+//
+//   void pop_front( )
+//     Precondition: size( ) > 0.
+//     Postcondition: The first item of the node has been removed (and its
+//     place in the array reset to Item( )).
+//
+// FUNCTIONS in the unrolled linked list toolkit (a list never has an empty
+// node, so the head pointer of an empty list is NULL):
+//   template <class Item>
+//   void ulist_clear(unrolled_node<Item>*& head_ptr)
+//     Precondition: head_ptr is the head pointer of an unrolled linked list.
+//     Postcondition: All nodes of the list have been returned to the heap,
+//     and the head_ptr is now NULL.
+//
+//   template <class Item>
+//   void ulist_copy(const unrolled_node<Item>* source_ptr,
+//                   unrolled_node<Item>*& head_ptr,
+//                   unrolled_node<Item>*& tail_ptr)
+//     Precondition: source_ptr is the head pointer of an unrolled linked list.
+//     Postcondition: head_ptr and tail_ptr are the head and tail pointers for
+//     a new list that contains the same items as the list pointed to by
+//     source_ptr (in nodes holding the same items as source's). The original
+//     list is unaltered.
+//
+//   template <class Item>
+//   void ulist_head_insert(unrolled_node<Item>*& head_ptr, const Item& entry)
+//     Precondition: head_ptr is the head pointer of an unrolled linked list.
+//     Postcondition: entry is now the first item of the list: it has been put
+//     in the head node if that has room, otherwise in a new head node.
+//
+//   template <class Item>
+//   void ulist_head_remove(unrolled_node<Item>*& head_ptr)
+//     Precondition: head_ptr is the head pointer of an unrolled linked list,
+//     with at least one item.
+//     Postcondition: The first item of the list has been removed (and the
+//     head node returned to the heap if that left it empty).
+//
+//   template <class Item>
+//   std::size_t ulist_length(const unrolled_node<Item>* head_ptr)
+//     Precondition: head_ptr is the head pointer of an unrolled linked list.
+//     Postcondition: The value returned is the number of items in the list
+//     (found in time proportional to the number of nodes).
+//
+//   An item of a list is named by a node pointer and an index: item i of
+//   the node (item 0 is the first), as for data(i). The next two functions
+//   are the unrolled forms of list_locate and list_search (see node2.h).
+//
+//   template <class NodePtr, class SizeType>
+//   NodePtr ulist_locate(NodePtr head_ptr, SizeType position,
+//                        std::size_t& index)
+//   The NodePtr may be either unrolled_node<Item>* or
+//   const unrolled_node<Item>*
+//     Precondition: head_ptr is the head pointer of an unrolled linked list,
+//     and position > 0.
+//     Postcondition: The return value points to the node holding the item at
+//     the specified position of the list (the first item is position 1),
+//     and index is that item's index in the node. If there is no such
+//     position, then the null pointer is returned. This takes time
+//     proportional to the number of nodes before that one.
+//
+//   template <class NodePtr, class Item>
+//   NodePtr ulist_search(NodePtr start_ptr, const Item& target,
+//                        std::size_t& index)
+//   The NodePtr may be either unrolled_node<Item>* or
+//   const unrolled_node<Item>*
+//     Precondition: start_ptr is NULL, or points to a node of an unrolled
+//     linked list and index <= start_ptr->size( ).
+//     Postcondition: The search starts at item index of the node start_ptr
+//     (or at the next node, if index is start_ptr->size( )). The return
+//     value points to the node of the first item found that is equal to
+//     target, and index is that item's index in the node. If there is no
+//     such item, the null pointer is returned. (To find the next copy,
+//     search again from the same node with index + 1.)
+//
+// FORWARD ITERATORS for an unrolled linked list:
+//   unrolled_node_iterator<Item> and const_unrolled_node_iterator<Item> step
+//   through the items of a list in order, like node_iterator and
+//   const_node_iterator: the constructor with an unrolled_node<Item>*
+//   parameter (the head pointer) gives an iterator at the first item, and
+//   the default constructor gives the iterator just past the end of a list.
+//   A change to the list invalidates its iterators.
+//
+// DYNAMIC MEMORY usage by the toolkit:
+//   If there is insufficient dynamic memory, then the following functions throw
+//   bad_alloc: the constructor, ulist_head_insert, ulist_copy.
+
+#ifndef MAIN_SAVITCH_UNODE_H
+#define MAIN_SAVITCH_UNODE_H
+#include <cstdlib>   // Provides NULL and size_t
+#include <iterator>  // Provides iterator and forward_iterator_tag
+
+namespace main_savitch_6B
+{
+    template <class Item>
+    class unrolled_node
+    {
+    public:
+        // TYPEDEF and MEMBER CONSTANT
+        typedef Item value_type;
+        static const std::size_t CAPACITY =
+            (sizeof(Item) < 128 - 2 * sizeof(std::size_t))
+            ? (128 - 2 * sizeof(std::size_t)) / sizeof(Item) : 1;
+        // CONSTRUCTOR
+        unrolled_node(unrolled_node* init_link = NULL)
+            { first = CAPACITY; link_field = init_link; }
+        // MODIFICATION MEMBER FUNCTIONS
+        Item& data(std::size_t i) { return data_field[first + i]; }
+        Item* items_begin( ) { return data_field + first; }
+        Item* items_end( ) { return data_field + CAPACITY; }
+        unrolled_node* link( ) { return link_field; }
+        void set_link(unrolled_node* new_link) { link_field = new_link; }
+        void push_front(const Item& entry);
+        void pop_front( );
+        // CONST MEMBER FUNCTIONS
+        const Item& data(std::size_t i) const { return data_field[first + i]; }
+        const Item* items_begin( ) const { return data_field + first; }
+        const Item* items_end( ) const { return data_field + CAPACITY; }
+        const unrolled_node* link( ) const { return link_field; }
+        std::size_t size( ) const { return CAPACITY - first; }
+        bool is_full( ) const { return first == 0; }
+    private:
+        Item data_field[CAPACITY];
+        std::size_t first;
+        unrolled_node *link_field;
+    };
+
+    // FUNCTIONS to manipulate an unrolled linked list:
+    template <class Item>
+    void ulist_clear(unrolled_node<Item>*& head_ptr);
+
+    template <class Item>
+    void ulist_copy(const unrolled_node<Item>* source_ptr,
+                    unrolled_node<Item>*& head_ptr,
+                    unrolled_node<Item>*& tail_ptr);
+
+    template <class Item>
+    void ulist_head_insert(unrolled_node<Item>*& head_ptr, const Item& entry);
+
+    template <class Item>
+    void ulist_head_remove(unrolled_node<Item>*& head_ptr);
+
+    template <class Item>
+    std::size_t ulist_length(const unrolled_node<Item>* head_ptr);
+
+    template <class NodePtr, class SizeType>
+    NodePtr ulist_locate(NodePtr head_ptr, SizeType position,
+                         std::size_t& index);
+
+    template <class NodePtr, class Item>
+    NodePtr ulist_search(NodePtr start_ptr, const Item& target,
+                         std::size_t& index);
+
+    // FORWARD ITERATORS to step through the items of an unrolled linked list
+    // (see node2.h for the same iterators over a node<Item> list)
+
+    template <class Item>
+    class unrolled_node_iterator
+    : public std::iterator<std::forward_iterator_tag, Item>
+    {
+    public:
+    	unrolled_node_iterator(unrolled_node<Item>* initial = NULL)
+	    {
+		current = initial;
+		item = (initial != NULL) ? initial->items_begin( ) : NULL;
+	    }
+	Item& operator *( ) const
+	    { return *item; }
+	unrolled_node_iterator& operator ++( ) // Prefix ++
+	    {
+		if (++item == current->items_end( ))
+		{
+		    current = current->link( );
+		    item = (current != NULL) ? current->items_begin( ) : NULL;
+		}
+		return *this;
+	    }
+	unrolled_node_iterator operator ++(int) // Postfix ++
+	    {
+		unrolled_node_iterator original(*this);
+		++*this;
+		return original;
+	    }
+	bool operator ==(const unrolled_node_iterator other) const
+	    { return item == other.item; }
+	bool operator !=(const unrolled_node_iterator other) const
+	    { return item != other.item; }
+    private:
+	unrolled_node<Item>* current;
+	Item* item;  // The item of current that the iterator is at
+    };
+
+    template <class Item>
+    class const_unrolled_node_iterator
+    : public std::iterator<std::forward_iterator_tag, const Item>
+    {
+    public:
+    	const_unrolled_node_iterator(const unrolled_node<Item>* initial = NULL)
+	    {
+		current = initial;
+		item = (initial != NULL) ? initial->items_begin( ) : NULL;
+	    }
+	const Item& operator *( ) const
+	    { return *item; }
+	const_unrolled_node_iterator& operator ++( ) // Prefix ++
+	    {
+		if (++item == current->items_end( ))
+		{
+		    current = current->link( );
+		    item = (current != NULL) ? current->items_begin( ) : NULL;
+		}
+		return *this;
+	    }
+	const_unrolled_node_iterator operator ++(int) // Postfix ++
+	    {
+		const_unrolled_node_iterator original(*this);
+		++*this;
+		return original;
+	    }
+	bool operator ==(const const_unrolled_node_iterator other) const
+	    { return item == other.item; }
+	bool operator !=(const const_unrolled_node_iterator other) const
+	    { return item != other.item; }
+    private:
+	const unrolled_node<Item>* current;
+	const Item* item;  // The item of current that the iterator is at
+    };
+
+}
+
+#include "unode.template"
+#endif
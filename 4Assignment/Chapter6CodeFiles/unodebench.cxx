@@ -0,0 +1,272 @@
+// FILE: unodebench.cxx
+// A benchmark program comparing the two linked list layouts of this
+// directory: node<Item> from node2.h (one item per node) and
+// unrolled_node<Item> from unode.h (up to CAPACITY items per node), for
+// int, double and std::string items (strings of up to 7 characters, short
+// enough to be stored inside the string object).
+// For each type and layout it times:
+//   insert  - building a list of N items with list_head_insert or
+//             ulist_head_insert (and then clearing it, which is not timed)
+//   iterate - PASSES passes over the list with const_node_iterator or
+//             const_unrolled_node_iterator, adding up a weight for each item
+// and writes the nanoseconds per item of each to cout, along with the
+// speedup of the unrolled layout. It then does the same for the bags built on
+// the two layouts, bag<Item> from bag5.h and ubag<Item> from ubag.h, timing:
+//   insert  - inserting N items into an empty bag
+//   count   - COUNTS calls of count (each looks at every item)
+//   erase   - erase of one value from the bag (a copy of the bag, not timed)
+// and checks that both bags give the same results. node<Item> uses node_pool
+// (see node2.h) unless the program is compiled with
+// -DMAIN_SAVITCH_NO_NODE_POOL, in which case each node comes from operator
+// new.
+
+#include <chrono>      // Provides steady_clock
+#include <cstdlib>     // Provides EXIT_SUCCESS, size_t
+#include <iomanip>     // Provides setw, setprecision
+#include <iostream>    // Provides cout
+#include <string>      // Provides string, to_string
+#include "bag5.h"
+#include "node2.h"
+#include "ubag.h"
+#include "unode.h"
+using namespace std;
+using namespace main_savitch_6B;
+
+const size_t N = 1 << 20;   // Items in each list
+const int PASSES = 20;      // Passes of the iterate test
+const int COUNTS = 10;      // Calls of count in the bag count test
+
+// PROTOTYPES for functions used by this benchmark program:
+
+void make_value(int& value, size_t i);
+void make_value(double& value, size_t i);
+void make_value(string& value, size_t i);
+// Postcondition: value has been set to an item that depends on i.
+
+long weight(int value);
+long weight(double value);
+long weight(const string& value);
+// Postcondition: A number derived from value is returned (summed by the
+// benchmark so the compiler can't drop the work).
+
+double seconds_since(chrono::steady_clock::time_point start);
+// Postcondition: The return value is the time in seconds from start to now.
+
+template <class Item>
+void bench_type(const char name[ ]);
+// Postcondition: The insert and iterate tests (see the top of this file)
+// have been timed for both layouts with Item items, and one row of results
+// has been written to cout.
+
+template <class Item>
+void bench_bag(const char name[ ]);
+// Postcondition: The insert, count and erase tests of the bags (see the top
+// of this file) have been timed for bag<Item> and ubag<Item>, and one row of
+// results has been written to cout.
+
+int main( )
+{
+    cout << N << " items, " << PASSES << " iterate passes; CAPACITY of "
+         << "unrolled_node: int " << unrolled_node<int>::CAPACITY
+         << ", double " << unrolled_node<double>::CAPACITY
+         << ", string " << unrolled_node<string>::CAPACITY << endl;
+    cout << setw(8) << "item"
+         << setw(14) << "node ins" << setw(14) << "unrolled ins"
+         << setw(10) << "speedup"
+         << setw(14) << "node iter" << setw(14) << "unrolled iter"
+         << setw(10) << "speedup" << "   (ns per item)" << endl;
+    bench_type<int>("int");
+    bench_type<double>("double");
+    bench_type<string>("string");
+
+    cout << endl << "bag (bag5.h) and ubag (ubag.h), " << COUNTS
+         << " counts" << endl;
+    cout << setw(8) << "item"
+         << setw(12) << "bag ins" << setw(12) << "ubag ins"
+         << setw(12) << "bag count" << setw(12) << "ubag count"
+         << setw(10) << "speedup"
+         << setw(12) << "bag erase" << setw(12) << "ubag erase"
+         << "   (ns per item)" << endl;
+    bench_bag<int>("int");
+    bench_bag<double>("double");
+    bench_bag<string>("string");
+    return EXIT_SUCCESS;
+}
+
+void make_value(int& value, size_t i)
+{
+    value = int(i);
+}
+
+void make_value(double& value, size_t i)
+{
+    value = i * 0.5;
+}
+
+void make_value(string& value, size_t i)
+{
+    value = to_string(i % 10000000);
+}
+
+long weight(int value)
+{
+    return value;
+}
+
+long weight(double value)
+{
+    return long(value);
+}
+
+long weight(const string& value)
+{
+    return long(value.size( )) + value[0];
+}
+
+double seconds_since(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now( ) - start).count( );
+}
+
+template <class Item>
+void bench_type(const char name[ ])
+{
+    Item *values = new Item[N];
+    node<Item> *head_ptr = NULL;
+    unrolled_node<Item> *uhead_ptr = NULL;
+    double node_insert, unrolled_insert, node_iterate, unrolled_iterate;
+    long node_sum = 0, unrolled_sum = 0;
+    chrono::steady_clock::time_point start;
+    size_t i;
+    int pass;
+
+    for (i = 0; i < N; ++i)
+        make_value(values[i], i);
+
+    // Warming up the allocators (and node_pool's slabs) with one untimed
+    // round of each
+    for (i = 0; i < N; ++i)
+        list_head_insert(head_ptr, values[i]);
+    list_clear(head_ptr);
+    for (i = 0; i < N; ++i)
+        ulist_head_insert(uhead_ptr, values[i]);
+    ulist_clear(uhead_ptr);
+
+    // Insert tests
+    start = chrono::steady_clock::now( );
+    for (i = 0; i < N; ++i)
+        list_head_insert(head_ptr, values[i]);
+    node_insert = seconds_since(start);
+
+    start = chrono::steady_clock::now( );
+    for (i = 0; i < N; ++i)
+        ulist_head_insert(uhead_ptr, values[i]);
+    unrolled_insert = seconds_since(start);
+
+    // Iterate tests (on the lists just built)
+    const node<Item> *cursor = head_ptr;
+    const unrolled_node<Item> *ucursor = uhead_ptr;
+    const_node_iterator<Item> end;
+    const_unrolled_node_iterator<Item> uend;
+
+    start = chrono::steady_clock::now( );
+    for (pass = 0; pass < PASSES; ++pass)
+    {
+        for (const_node_iterator<Item> it(cursor); it != end; ++it)
+            node_sum += weight(*it);
+    }
+    node_iterate = seconds_since(start);
+
+    start = chrono::steady_clock::now( );
+    for (pass = 0; pass < PASSES; ++pass)
+    {
+        for (const_unrolled_node_iterator<Item> it(ucursor); it != uend; ++it)
+            unrolled_sum += weight(*it);
+    }
+    unrolled_iterate = seconds_since(start);
+
+    if (node_sum != unrolled_sum || list_length(cursor) != N
+        || ulist_length(ucursor) != N)
+        cout << "MISMATCH for " << name << endl;
+
+    list_clear(head_ptr);
+    ulist_clear(uhead_ptr);
+    delete [ ] values;
+
+    cout << fixed << setprecision(2)
+         << setw(8) << name
+         << setw(14) << node_insert * 1e9 / N
+         << setw(14) << unrolled_insert * 1e9 / N
+         << setw(9) << node_insert / unrolled_insert << "x"
+         << setw(14) << node_iterate * 1e9 / (double(N) * PASSES)
+         << setw(14) << unrolled_iterate * 1e9 / (double(N) * PASSES)
+         << setw(9) << node_iterate / unrolled_iterate << "x" << endl;
+}
+
+template <class Item>
+void bench_bag(const char name[ ])
+{
+    Item *values = new Item[N];
+    bag<Item> listed;
+    ubag<Item> unrolled;
+    double listed_insert, unrolled_insert, listed_count, unrolled_count;
+    double listed_erase, unrolled_erase;
+    size_t listed_found = 0, unrolled_found = 0, listed_erased, unrolled_erased;
+    chrono::steady_clock::time_point start;
+    size_t i;
+    int c;
+
+    for (i = 0; i < N; ++i)
+        make_value(values[i], i % 1000);
+
+    // Insert tests
+    start = chrono::steady_clock::now( );
+    for (i = 0; i < N; ++i)
+        listed.insert(values[i]);
+    listed_insert = seconds_since(start);
+
+    start = chrono::steady_clock::now( );
+    for (i = 0; i < N; ++i)
+        unrolled.insert(values[i]);
+    unrolled_insert = seconds_since(start);
+
+    // Count tests
+    start = chrono::steady_clock::now( );
+    for (c = 0; c < COUNTS; ++c)
+        listed_found += listed.count(values[c]);
+    listed_count = seconds_since(start);
+
+    start = chrono::steady_clock::now( );
+    for (c = 0; c < COUNTS; ++c)
+        unrolled_found += unrolled.count(values[c]);
+    unrolled_count = seconds_since(start);
+
+    // Erase tests (on copies, so that the copying isn't timed)
+    {
+        bag<Item> copy(listed);
+        start = chrono::steady_clock::now( );
+        listed_erased = copy.erase(values[0]);
+        listed_erase = seconds_since(start);
+    }
+    {
+        ubag<Item> copy(unrolled);
+        start = chrono::steady_clock::now( );
+        unrolled_erased = copy.erase(values[0]);
+        unrolled_erase = seconds_since(start);
+    }
+
+    if (listed_found != unrolled_found || listed_erased != unrolled_erased
+        || listed.size( ) != N || unrolled.size( ) != N)
+        cout << "MISMATCH for " << name << endl;
+    delete [ ] values;
+
+    cout << fixed << setprecision(2)
+         << setw(8) << name
+         << setw(12) << listed_insert * 1e9 / N
+         << setw(12) << unrolled_insert * 1e9 / N
+         << setw(12) << listed_count * 1e9 / (double(N) * COUNTS)
+         << setw(12) << unrolled_count * 1e9 / (double(N) * COUNTS)
+         << setw(9) << listed_count / unrolled_count << "x"
+         << setw(12) << listed_erase * 1e9 / N
+         << setw(12) << unrolled_erase * 1e9 / N << endl;
+}
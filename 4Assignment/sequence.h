@@ -1,27 +1,68 @@
 // FILE: sequence.h
 //////////////////////////////////////////////////////////////////////
-// TEMPLATE CLASS PROVIDED: sequence<T> (a container class for a list of items,
-//                 where each list may have a designated item called
-//                 the current item)
+// TEMPLATE CLASS PROVIDED: sequence<T, N, Alloc> (a container class for a
+//                 list of items, where each list may have a designated
+//                 item called the current item)
+//
+// TEMPLATE PARAMETERS for the sequence<T, N, Alloc> template class:
+//   T     - the data type of the items (see value_type below).
+//   N     - the # of items kept inside the sequence object itself
+//           (default 10). A sequence of up to N items needs no dynamic
+//           memory; the first add beyond that moves the items to a
+//           dynamic array, which then grows geometrically (doubling)
+//           as needed, so there is no limit on the # of items.
+//   Alloc - the allocator used for the dynamic array (default
+//           std::allocator<T>); any allocator meeting the standard
+//           Allocator requirements (an arena allocator, say) may be
+//           used.
 //
 // TYPEDEFS and MEMBER FA2019 for the sequence<T> template class:
 //   typedef ____ value_type
 //     sequence<T>::value_type is the T data type from the template parameter.
 //     It is the data type of the items in the sequence.
 //     It may be any of the C++ built-in types (int, char, etc.), or a
-//     class with a default constructor, an assignment operator, and a
-//     copy constructor.
+//     class with a copy constructor, a move constructor, a copy
+//     assignment operator and a move assignment operator.
 //   typedef ____ size_type
 //     sequence<T>::size_type is the data type of any variable that keeps
 //     track of how many items of type T are in a sequence.
-//   static const size_type CAPACITY = _____
-//     sequence<T>::CAPACITY is the maximum number of items T that a
-//     sequence can hold.
+//   typedef ____ allocator_type
+//     sequence<T>::allocator_type is the Alloc template parameter.
+//   typedef ____ iterator
+//   typedef ____ const_iterator
+//     Random-access iterators over the items, from the first to the last
+//     (iterator gives read/write access, const_iterator read-only
+//     access). The items are always stored contiguously, so these are
+//     plain pointers and standard algorithms (std::sort, std::accumulate,
+//     std::reduce, ...) and SIMD loops can work on them directly. (The
+//     accessors are items_begin and items_end, since end moves the
+//     cursor.) Any change to the sequence other than through an
+//     iterator invalidates all iterators.
+//   static const size_type INLINE_CAPACITY = N
+//     sequence<T>::INLINE_CAPACITY is the # of items the sequence holds
+//     without dynamic memory.
 //
-// CONSTRUCTOR for the sequence<T> class:
-//   sequence()
+// CONSTRUCTORS and DESTRUCTOR for the sequence<T> class:
+//   sequence(const allocator_type& alloc = allocator_type())
+//     Pre:  (none)
+//     Post: The sequence has been initialized as an empty sequence (with
+//           capacity() == INLINE_CAPACITY) that will use a copy of alloc
+//           for its dynamic array.
+//   sequence(const sequence& source)
 //     Pre:  (none)
-//     Post: The sequence has been initialized as an empty sequence.
+//     Post: The sequence has been initialized as a copy of source (same
+//           items and current item); its allocator is the one
+//           std::allocator_traits selects for copying source's.
+//   sequence(sequence&& source)
+//     Pre:  (none)
+//     Post: The sequence has taken over the items and current item (and
+//           the allocator) of source, which is left an empty sequence.
+//           A dynamic array is taken over without copying; items held
+//           inside source are moved one by one. Doesn't throw if T's
+//           move constructor doesn't.
+//   ~sequence()
+//     Post: All items have been destroyed and the dynamic array (if any)
+//           has been given back to the allocator.
 //
 // MODIFICATION MEMBER FUNCTIONS for the sequence<T> class:
 //   void start()
@@ -43,23 +84,90 @@
 //           there is no longer any current item. Otherwise, the new current
 //           item is the item immediately before the original current item.
 //   void add(const value_type& entry)
-//     Pre:  size() < CAPACITY.
+//     Pre:  (none)
 //     Post: A new copy of entry has been inserted in the sequence after
 //           the current item. If there was no current item, then the new
 //           entry has been inserted as new first item of the sequence. In
 //           either case, the newly added item is now the current item of
 //           the sequence.
+//   void insert_range(const value_type* first, const value_type* last)
+//     Pre:  [first, last) is a valid range of items.
+//     Post: Copies of the items in [first, last) have been inserted, in
+//           order, before the current item (at the front of the
+//           sequence if there was no current item), and the first of
+//           them is now the current item. If the range is empty, the
+//           sequence is unchanged.
+//   void add_range(const value_type* first, const value_type* last)
+//     Pre:  [first, last) is a valid range of items.
+//     Post: Copies of the items in [first, last) have been inserted, in
+//           order, after the current item (at the front of the sequence
+//           if there was no current item, as add does), and the last of
+//           them is now the current item; the result is the same as
+//           adding the items one at a time from first to last. If the
+//           range is empty, the sequence is unchanged.
+//     Note: insert_range and add_range shift the items after the
+//           insertion point once and grow the array at most once, so
+//           k items cost O(size() + k) rather than O(size() * k).
 //   void remove_current()
 //     Pre:  is_item() returns true.
 //     Post: The current item has been removed from the sequence, and
 //           the item after this (if there is one) is now the new current
 //           item. If the current item was already the last item in the
 //           sequence, then there is no longer any current item.
+//   void reserve(size_type new_capacity)
+//     Pre:  (none)
+//     Post: capacity() >= new_capacity, so items may be added until the
+//           size reaches new_capacity without any further allocation.
+//           The items and the current item are unchanged.
+//   iterator items_begin()
+//   iterator items_end()
+//   T* data()
+//     Pre:  (none)
+//     Post: A pointer to the first item (items_begin and data) or just
+//           past the last item (items_end) is returned: data()[0] through
+//           data()[size()-1] are the items in order, and may be changed
+//           in place.
+//   sequence& operator=(const sequence& source)
+//     Pre:  (none)
+//     Post: The sequence is a copy of source (same items and current
+//           item). Its allocator is replaced by source's only if
+//           alloc_traits::propagate_on_container_copy_assignment is true;
+//           otherwise it keeps its own and the copies are made with it.
+//   sequence& operator=(sequence&& source)
+//     Pre:  (none)
+//     Post: The sequence holds the items and current item that source
+//           had, and source is empty. If
+//           propagate_on_container_move_assignment is true, or the two
+//           allocators compare equal, source's dynamic array (and, if
+//           the trait is true, its allocator) is taken over without
+//           copying. Otherwise the sequence keeps its own allocator and
+//           the items are moved one by one into memory from it. Doesn't
+//           throw if the first case is certain (the trait is true or
+//           Alloc is an empty class, so all its objects are equal) and
+//           T's move constructor doesn't throw.
+//   void swap(sequence& other)
+//     Pre:  (none)
+//     Post: The items and current items of the sequence and other have
+//           been exchanged. The allocators are exchanged too if
+//           propagate_on_container_swap is true; otherwise each keeps
+//           its own. Dynamic arrays change hands without copying if
+//           the trait is true or the allocators compare equal; items
+//           held inside the objects, and all items when unequal
+//           allocators stay put, are moved. Doesn't throw when the
+//           first case is certain (as for move assignment) and T's move
+//           constructor doesn't throw.
 //
 // CONSTANT MEMBER FUNCTIONS for the sequence<T> class:
 //   size_type size() const
 //     Pre:  (none)
 //     Post: The return value is the number of items in the sequence.
+//   size_type capacity() const
+//     Pre:  (none)
+//     Post: The return value is the # of items the sequence can hold
+//           before it has to allocate (more) dynamic memory.
+//   allocator_type get_allocator() const
+//     Pre:  (none)
+//     Post: A copy of the sequence's allocator is returned.
 //   bool is_item() const
 //     Pre:  (none)
 //     Post: A true return value indicates that there is a valid
@@ -69,42 +177,120 @@
 //   value_type current() const
 //     Pre:  is_item() returns true.
 //     Post: The item returned is the current item in the sequence.
+//   const_iterator items_begin() const
+//   const_iterator items_end() const
+//   const T* data() const
+//     Pre:  (none)
+//     Post: As for the non-constant versions, but read-only.
 // VALUE SEMANTICS for the sequence<T> class:
 //    Assignments and the copy constructor may be used with sequence
-//    objects.
+//    objects. Assignment copies from an lvalue and moves from an rvalue;
+//    whether the right-hand side's allocator comes along is decided by
+//    std::allocator_traits<Alloc> (see operator= and swap), so a
+//    sequence using an arena allocator never ends up holding memory
+//    from another sequence's arena unless Alloc asks for that.
+//
+// PERFORMANCE NOTE: add and remove_current shift the items after the
+//    current item by one position. For a trivially copyable T (int,
+//    double, plain structs, ...) the items are shifted with one memmove,
+//    and moved to a bigger array with one memcpy; for any other T
+//    (std::string, ...) they are moved, so no item is copied just to
+//    make room.
 
-#ifndef SEQUENCE_H
-#define SEQUENCE_H
+#ifndef A04_SEQUENCE_H
+#define A04_SEQUENCE_H
 
-#include <cstdlib>  // provides size_t
+#include <cstdlib>      // provides size_t
+#include <memory>       // provides allocator, allocator_traits
+#include <type_traits>  // provides aligned_storage, is_empty,
+                        // is_trivially_copyable
 
 namespace CS3358_FA2019_A04_sequence
 {
-   template <class T>
+   template <class T, std::size_t N = 10,
+             class Alloc = std::allocator<T> >
    class sequence
    {
    public:
       // TYPEDEFS and MEMBER FA2019
+      typedef T value_type;
       typedef size_t size_type;
-      static const size_type CAPACITY = 10;
-      // CONSTRUCTOR
-      sequence();
+      typedef Alloc allocator_type;
+      typedef T* iterator;
+      typedef const T* const_iterator;
+      static const size_type INLINE_CAPACITY = N;
+      // CONSTRUCTORS and DESTRUCTOR
+      sequence(const allocator_type& alloc = allocator_type());
+      sequence(const sequence& source);
+      sequence(sequence&& source)
+         noexcept(std::is_nothrow_move_constructible<T>::value);
+      ~sequence();
       // MODIFICATION MEMBER FUNCTIONS
       void start();
       void end();
       void advance();
       void move_back();
       void add(const T& entry);
+      void insert_range(const T* first, const T* last);
+      void add_range(const T* first, const T* last);
       void remove_current();
+      void reserve(size_type new_capacity);
+      sequence& operator=(const sequence& source);
+      sequence& operator=(sequence&& source)
+         noexcept((std::allocator_traits<Alloc>::
+                      propagate_on_container_move_assignment::value
+                   || std::is_empty<Alloc>::value)
+                  && std::is_nothrow_move_constructible<T>::value);
+      void swap(sequence& other)
+         noexcept((std::allocator_traits<Alloc>::
+                      propagate_on_container_swap::value
+                   || std::is_empty<Alloc>::value)
+                  && std::is_nothrow_move_constructible<T>::value);
+      iterator items_begin();
+      iterator items_end();
+      T* data();
       // CONSTANT MEMBER FUNCTIONS
       size_type size() const;
+      size_type capacity() const;
+      allocator_type get_allocator() const;
       bool is_item() const;
       T current() const;
+      const_iterator items_begin() const;
+      const_iterator items_end() const;
+      const T* data() const;
 
    private:
-      T data[CAPACITY];
+      static_assert(N >= 1, "sequence<T, N>: N must be at least 1");
+      typedef std::allocator_traits<Alloc> alloc_traits;
+      typedef typename std::aligned_storage<sizeof(T),
+                                            alignof(T)>::type slot;
+      slot inline_items[N];
+      T* buffer;
       size_type used;
+      size_type buffer_capacity;
       size_type current_index;
+      allocator_type alloc;
+      // HELPER FUNCTIONS
+      typedef typename std::is_trivially_copyable<T>::type is_bitwise;
+      T* inline_data();
+      bool is_inline() const;
+      bool in_buffer(const T* p) const;
+      void release();
+      void take(sequence& source);
+      void copy_from(const sequence& source);
+      void move_items_from(sequence& source);
+      void relocate(T* from, size_type n, T* to);
+      void relocate(T* from, size_type n, T* to, std::true_type);
+      void relocate(T* from, size_type n, T* to, std::false_type);
+      void make_room(size_type count);
+      void insert_at(size_type position, const T* first, const T* last);
+      void insert_at(size_type position, const T* first, const T* last,
+                     std::true_type);
+      void insert_at(size_type position, const T* first, const T* last,
+                     std::false_type);
+      static void shift_left(T* first, T* last);
+      static void shift_left(T* first, T* last, std::true_type);
+      static void shift_left(T* first, T* last, std::false_type);
    };
 }
 
@@ -0,0 +1,156 @@
+// FILE: sequenceBench.cpp
+// A benchmark program for the shifting done by sequence<T>'s add and
+// remove_current, for three kinds of item:
+//   double      - trivially copyable, 8 bytes (shifted with memmove)
+//   std::string - 40 characters, so every copy allocates (shifted by
+//                 move-assignment)
+//   Blob64      - a trivially copyable 64-byte struct (memmove)
+// Each round fills a sequence with n items by adding every item at the
+// front (so each add shifts every item already there), then empties it
+// with remove_current from the front (so each removal shifts every item
+// left). n is 10 (the items stay inside the sequence object) and 100
+// (the items are in a dynamic array). Rounds run on BATCH sequences at
+// a time, so the clock is read once per batch rather than once per
+// round. The average time per add and per remove_current, and the
+// millions of items shifted per second, are written to cout.
+
+#include <chrono>      // provides steady_clock
+#include <cstdlib>     // provides EXIT_SUCCESS
+#include <iomanip>     // provides setw, setprecision
+#include <iostream>    // provides cout
+#include <string>      // provides string
+#include <vector>      // provides vector
+#include "sequence.h"
+using namespace CS3358_FA2019_A04_sequence;
+using namespace std;
+
+// A plain 64-byte record: trivially copyable but too big for registers
+struct Blob64
+{
+   char bytes[64];
+};
+
+const long ROUNDS = 200000;
+const long BATCH = 250;      // ROUNDS must be a multiple of BATCH
+volatile long sink;   // keeps results alive so timed work isn't elided
+
+// PROTOTYPES for functions used by this benchmark program:
+
+void make_value(double& value, int i);
+void make_value(string& value, int i);
+void make_value(Blob64& value, int i);
+// Pre:  (none)
+// Post: value has been set to an item that depends on i.
+
+long weight(double value);
+long weight(const string& value);
+long weight(const Blob64& value);
+// Pre:  (none)
+// Post: A number derived from value is returned (summed by the
+//       benchmark into sink so the compiler can't drop the work).
+
+template <class T>
+void bench_type(const char name[], int n);
+// Pre:  n >= 1
+// Post: ROUNDS rounds of n front adds and n front removals (see the
+//       top of this file) have been timed on a sequence<T> and one row
+//       of results has been written to cout.
+
+int main()
+{
+   const int SIZES[] = { 10, 100 };
+
+   cout << "sequence<T>::INLINE_CAPACITY = "
+        << sequence<double>::INLINE_CAPACITY << ", " << ROUNDS
+        << " rounds" << endl;
+   cout << setw(12) << "item" << setw(6) << "n" << setw(14) << "ns/add"
+        << setw(14) << "ns/remove" << setw(20) << "Mitems shifted/s"
+        << endl;
+   for (int i = 0; i < 2; ++i)
+   {
+      bench_type<double>("double", SIZES[i]);
+      bench_type<string>("string(40)", SIZES[i]);
+      bench_type<Blob64>("Blob64", SIZES[i]);
+   }
+   return EXIT_SUCCESS;
+}
+
+void make_value(double& value, int i)
+{
+   value = i * 0.5;
+}
+
+void make_value(string& value, int i)
+{
+   value.assign(40, char('a' + i % 26));
+}
+
+void make_value(Blob64& value, int i)
+{
+   for (int k = 0; k < 64; ++k)
+      value.bytes[k] = char(i + k);
+}
+
+long weight(double value)
+{
+   return long(value);
+}
+
+long weight(const string& value)
+{
+   return value[0];
+}
+
+long weight(const Blob64& value)
+{
+   return value.bytes[63];
+}
+
+template <class T>
+void bench_type(const char name[], int n)
+{
+   vector<T> values(n);
+   for (int i = 0; i < n; ++i)
+      make_value(values[i], i);
+
+   vector<sequence<T> > batch(BATCH);
+   long check = 0;
+   double add_ns = 0, remove_ns = 0;
+   for (long round = 0; round < ROUNDS; round += BATCH)
+   {
+      chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+      for (long b = 0; b < BATCH; ++b)
+      {
+         sequence<T>& s = batch[b];
+         for (int i = 0; i < n; ++i)
+         {
+            // No current item makes add insert at the front
+            s.start();
+            if (s.is_item())
+               s.move_back();
+            s.add(values[i]);
+         }
+      }
+      chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+      for (long b = 0; b < BATCH; ++b)
+      {
+         sequence<T>& s = batch[b];
+         check += weight(s.current());
+         s.start();
+         while (s.is_item())
+            s.remove_current();
+      }
+      chrono::steady_clock::time_point t2 = chrono::steady_clock::now();
+
+      add_ns += chrono::duration<double, nano>(t1 - t0).count();
+      remove_ns += chrono::duration<double, nano>(t2 - t1).count();
+   }
+   sink = check;
+
+   // Filling shifts 0 + 1 + ... + (n-1) items, and so does emptying
+   double ops = double(ROUNDS) * n;
+   double shifted = 2.0 * ROUNDS * (n * (n - 1) / 2);
+   cout << setw(12) << name << setw(6) << n << fixed << setprecision(2)
+        << setw(14) << add_ns / ops << setw(14) << remove_ns / ops
+        << setw(20) << shifted / (add_ns + remove_ns) * 1e3 << endl;
+}
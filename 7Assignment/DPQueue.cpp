@@ -17,6 +17,9 @@
 //          NOTE: The size of the dynamic array (thus capacity) can
 //                be resized up or down where needed or appropriate
 //                by calling resize(...).
+//   3. A p_queue that has been moved from owns no dynamic array:
+//      heap is 0 and capacity (and used) is 0; push grows it again
+//      through resize(...) like any full p_queue.
 // NOTE: Private helper functions are implemented at the bottom of
 // this file along with their precondition/postcondition contracts.
 
@@ -24,6 +27,7 @@
 #include <iostream>  // provides cin, cout
 #include <iomanip>   // provides setw
 #include <cmath>     // provides log2
+#include <utility>   // provides swap
 #include "DPQueue.h"
 
 using namespace std;
@@ -105,6 +109,16 @@ p_queue::p_queue(size_type initial_capacity) : capacity(initial_capacity),
          heap[index] = src.heap[index];
    }
 
+   p_queue::p_queue(p_queue&& src) noexcept : heap(src.heap),
+                                              capacity(src.capacity),
+                                              used(src.used)
+   {
+      // Taking over src's heap array and leaving src without one
+      src.heap = 0;
+      src.capacity = 0;
+      src.used = 0;
+   }
+
    // ~DESTRUCTOR
    p_queue::~p_queue()
    {
@@ -113,31 +127,22 @@ p_queue::p_queue(size_type initial_capacity) : capacity(initial_capacity),
    }
 
    // MODIFICATION MEMBER FUNCTIONS
-   p_queue& p_queue::operator=(const p_queue& rhs)
+   p_queue& p_queue::operator=(p_queue rhs) noexcept
    {
-      // If same (this) object return this
-      if (this == &rhs)
-         return *this;
-
-      // Temp array to store contents of rhs
-      ItemType *temp_heap = new ItemType[rhs.capacity];
-
-      // rsh content transfer
-      for (size_type index = 0; index < rhs.used; ++index)
-      {
-         temp_heap[index] = rhs.heap[index];
-      }
-
-      // Deallocating old dynamic array
-      delete [] heap;
-
-      // Assigning to new members
-      heap = temp_heap;
-      capacity = rhs.capacity;
-      used = rhs.used;
+      // rhs is already a copy of (or was moved from) the right-hand
+      // side; trading contents with it hands the old heap array to
+      // rhs's destructor (self-assignment needs no special case)
+      swap(rhs);
       return *this;
    }
 
+   void p_queue::swap(p_queue& other) noexcept
+   {
+      std::swap(heap, other.heap);
+      std::swap(capacity, other.capacity);
+      std::swap(used, other.used);
+   }
+
    void p_queue::push(const value_type& entry, size_type priority)
    {
       // Resizing if at capacity
@@ -37,6 +37,13 @@
 //       is to ensure no attempt is made at allocating memory that's
 //       0 in amount).
 //
+//   p_queue(p_queue&& src) noexcept
+//     Pre:  (none)
+//     Post: The p_queue has taken over the items (and the dynamic
+//       array holding them) of src without copying or allocating;
+//       src is left an empty p_queue with no dynamic array (capacity
+//       0), which may still be pushed to, assigned to or destroyed.
+//
 // MODIFICATION MEMBER FUNCTIONS for the p_queue class:
 //   void push(const value_type& entry, size_type priority)
 //     Pre:  (none)
@@ -49,6 +56,12 @@
 //           p_queue. (If several items have the equal priority,
 //           then the implementation may decide which one to remove.)
 //
+//   void swap(p_queue& other) noexcept
+//     Pre:  (none)
+//     Post: The items of the p_queue and other (together with the
+//           dynamic arrays holding them) have been exchanged; nothing
+//           is copied or allocated.
+//
 // CONSTANT MEMBER FUNCTIONS for the p_queue class:
 //   size_type size() const
 //     Pre:  (none)
@@ -69,7 +82,10 @@
 //
 // VALUE SEMANTICS for the p_queue class:
 //   Assignments and the copy constructor may be used with p_queue
-//   objects.
+//   objects. Assignment takes its right-hand side by value (copy-
+//   and-swap): it copies from an lvalue, moves from an rvalue, and
+//   leaves the p_queue unchanged if the copy fails. Temporaries are
+//   moved rather than copied (see the move constructor).
 
 #ifndef D_P_QUEUE_H
 #define D_P_QUEUE_H
@@ -88,9 +104,11 @@ namespace CS3358_FA2019_A7
       // CONSTRUCTORS AND DESTRUCTOR
       p_queue(size_type initial_capacity = DEFAULT_CAPACITY);
       p_queue(const p_queue& src);
+      p_queue(p_queue&& src) noexcept;
       ~p_queue();
       // MODIFICATION MEMBER FUNCTIONS
-      p_queue& operator=(const p_queue& rhs);
+      p_queue& operator=(p_queue rhs) noexcept;
+      void swap(p_queue& other) noexcept;
       void push(const value_type& entry, size_type priority);
       void pop();
       // CONSTANT MEMBER FUNCTIONS